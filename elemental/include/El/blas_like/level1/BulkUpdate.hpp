@@ -0,0 +1,220 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_BLAS_BULKUPDATE_HPP
+#define EL_BLAS_BULKUPDATE_HPP
+
+namespace El {
+
+// Rather than queueing an (i,j,value) triplet per entry, the owners of each
+// row and of each column of the block are computed once. Since the columns of
+// the block are contiguous, the columns sent to each process map to a
+// contiguous range of its local columns, and the rows sent to it are
+// described by (first local row, run length) pairs. Each destination thus
+// receives a single message of the form
+//
+//   [localColBeg, numLocalCols, numRuns, (localRow,runLength) x numRuns]
+//
+// followed by the corresponding values, stored row by row. As a typical
+// block only touches a subset of the processes, both the metadata and the
+// values are exchanged with SparseAllToAll.
+template<typename T>
+void BulkUpdate
+(       AbstractDistMatrix<T>& A,
+  const vector<Int>& rows,
+  const Matrix<T>& block,
+        Int colOffset )
+{
+    EL_DEBUG_CSE
+    const Int numRows = rows.size();
+    const Int width = block.Width();
+    if( block.Height() != numRows )
+        LogicError
+        ("The block had ",block.Height()," rows but ",numRows,
+         " row indices were given");
+    if( colOffset < 0 || colOffset+width > A.Width() )
+        LogicError
+        ("Columns [",colOffset,",",colOffset+width,") are out of bounds for a ",
+         "matrix of width ",A.Width());
+    EL_DEBUG_ONLY(
+      for( Int iBlock=0; iBlock<numRows; ++iBlock )
+          if( rows[iBlock] < 0 || rows[iBlock] >= A.Height() )
+              LogicError
+              ("Row ",rows[iBlock]," is out of bounds for a matrix of height ",
+               A.Height());
+    )
+    const Grid& g = A.Grid();
+    if( !g.InGrid() )
+        return;
+    mpi::Comm comm = g.VCComm();
+    const int commSize = mpi::Size( comm );
+    const int colStride = A.ColStride();
+    const int rowStride = A.RowStride();
+    const int redundantSize = A.RedundantSize();
+
+    // Group the rows of the block by their owning row of the process grid and
+    // compress their local indices into runs
+    // ======================================================================
+    vector<vector<Int>> ownedRows(colStride);
+    vector<vector<Int>> rowRuns(colStride);
+    for( Int iBlock=0; iBlock<numRows; ++iBlock )
+    {
+        const Int i = rows[iBlock];
+        const int ownerRow = A.RowOwner(i);
+        const Int iLoc = A.LocalRow(i,ownerRow);
+        auto& runs = rowRuns[ownerRow];
+        const Int numRuns = runs.size() / 2;
+        if( numRuns > 0 && runs[2*numRuns-2]+runs[2*numRuns-1] == iLoc )
+        {
+            ++runs[2*numRuns-1];
+        }
+        else
+        {
+            runs.push_back( iLoc );
+            runs.push_back( 1 );
+        }
+        ownedRows[ownerRow].push_back( iBlock );
+    }
+
+    // Group the columns of the block by their owning column of the grid
+    // =================================================================
+    vector<vector<Int>> ownedCols(rowStride);
+    vector<Int> localColBegs(rowStride,0);
+    for( Int jBlock=0; jBlock<width; ++jBlock )
+    {
+        const Int j = colOffset + jBlock;
+        const int ownerCol = A.ColOwner(j);
+        if( ownedCols[ownerCol].empty() )
+            localColBegs[ownerCol] = A.LocalCol(j,ownerCol);
+        ownedCols[ownerCol].push_back( jBlock );
+    }
+
+    // Count the metadata and values for each destination
+    // ==================================================
+    // Every redundant copy of each entry is updated
+    vector<int> sendSizes(2*commSize,0);
+    for( int ownerCol=0; ownerCol<rowStride; ++ownerCol )
+    {
+        const Int numLocalCols = ownedCols[ownerCol].size();
+        if( numLocalCols == 0 )
+            continue;
+        for( int ownerRow=0; ownerRow<colStride; ++ownerRow )
+        {
+            const Int numOwnedRows = ownedRows[ownerRow].size();
+            if( numOwnedRows == 0 )
+                continue;
+            const int distRank = ownerRow + colStride*ownerCol;
+            for( int redundant=0; redundant<redundantSize; ++redundant )
+            {
+                const int owner =
+                  g.CoordsToVC
+                  (A.ColDist(),A.RowDist(),distRank,A.Root(),redundant);
+                sendSizes[2*owner] = 3 + rowRuns[ownerRow].size();
+                sendSizes[2*owner+1] = numOwnedRows*numLocalCols;
+            }
+        }
+    }
+    vector<int> recvSizes(2*commSize);
+    mpi::AllToAll( sendSizes.data(), 2, recvSizes.data(), 2, comm );
+
+    vector<int> metaSendCounts(commSize), valueSendCounts(commSize),
+                metaRecvCounts(commSize), valueRecvCounts(commSize);
+    for( int q=0; q<commSize; ++q )
+    {
+        metaSendCounts[q] = sendSizes[2*q];
+        valueSendCounts[q] = sendSizes[2*q+1];
+        metaRecvCounts[q] = recvSizes[2*q];
+        valueRecvCounts[q] = recvSizes[2*q+1];
+    }
+    SwapClear( sendSizes );
+    SwapClear( recvSizes );
+    vector<int> metaSendOffs, valueSendOffs, metaRecvOffs, valueRecvOffs;
+    const int totalMetaSend = Scan( metaSendCounts, metaSendOffs );
+    const int totalValueSend = Scan( valueSendCounts, valueSendOffs );
+    const int totalMetaRecv = Scan( metaRecvCounts, metaRecvOffs );
+    const int totalValueRecv = Scan( valueRecvCounts, valueRecvOffs );
+
+    // Pack
+    // ====
+    vector<Int> metaSendBuf;
+    vector<T> valueSendBuf;
+    FastResize( metaSendBuf, totalMetaSend );
+    FastResize( valueSendBuf, totalValueSend );
+    for( int ownerCol=0; ownerCol<rowStride; ++ownerCol )
+    {
+        const auto& cols = ownedCols[ownerCol];
+        const Int numLocalCols = cols.size();
+        if( numLocalCols == 0 )
+            continue;
+        for( int ownerRow=0; ownerRow<colStride; ++ownerRow )
+        {
+            const auto& rowInds = ownedRows[ownerRow];
+            const auto& runs = rowRuns[ownerRow];
+            if( rowInds.empty() )
+                continue;
+            const int distRank = ownerRow + colStride*ownerCol;
+            for( int redundant=0; redundant<redundantSize; ++redundant )
+            {
+                const int owner =
+                  g.CoordsToVC
+                  (A.ColDist(),A.RowDist(),distRank,A.Root(),redundant);
+                Int* meta = &metaSendBuf[metaSendOffs[owner]];
+                meta[0] = localColBegs[ownerCol];
+                meta[1] = numLocalCols;
+                meta[2] = runs.size() / 2;
+                std::copy( runs.begin(), runs.end(), &meta[3] );
+
+                T* values = &valueSendBuf[valueSendOffs[owner]];
+                for( const Int iBlock : rowInds )
+                    for( const Int jBlock : cols )
+                        *values++ = block(iBlock,jBlock);
+            }
+        }
+    }
+
+    // Exchange
+    // ========
+    vector<Int> metaRecvBuf;
+    vector<T> valueRecvBuf;
+    FastResize( metaRecvBuf, totalMetaRecv );
+    FastResize( valueRecvBuf, totalValueRecv );
+    mpi::SparseAllToAll
+    ( metaSendBuf, metaSendCounts, metaSendOffs,
+      metaRecvBuf, metaRecvCounts, metaRecvOffs, comm );
+    SwapClear( metaSendBuf );
+    mpi::SparseAllToAll
+    ( valueSendBuf, valueSendCounts, valueSendOffs,
+      valueRecvBuf, valueRecvCounts, valueRecvOffs, comm );
+    SwapClear( valueSendBuf );
+
+    // Unpack
+    // ======
+    auto& ALoc = A.Matrix();
+    for( int q=0; q<commSize; ++q )
+    {
+        if( metaRecvCounts[q] == 0 )
+            continue;
+        const Int* meta = &metaRecvBuf[metaRecvOffs[q]];
+        const T* values = &valueRecvBuf[valueRecvOffs[q]];
+        const Int localColBeg = meta[0];
+        const Int numLocalCols = meta[1];
+        const Int numRuns = meta[2];
+        for( Int run=0; run<numRuns; ++run )
+        {
+            const Int iLocBeg = meta[3+2*run];
+            const Int runLength = meta[4+2*run];
+            for( Int iLoc=iLocBeg; iLoc<iLocBeg+runLength; ++iLoc )
+                for( Int c=0; c<numLocalCols; ++c )
+                    ALoc(iLoc,localColBeg+c) += *values++;
+        }
+    }
+}
+
+} // namespace El
+
+#endif // ifndef EL_BLAS_BULKUPDATE_HPP
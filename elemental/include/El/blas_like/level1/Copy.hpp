@@ -12,6 +12,7 @@
 #include <El/blas_like/level1/Copy/internal_decl.hpp>
 #include <El/blas_like/level1/Copy/GeneralPurpose.hpp>
 #include <El/blas_like/level1/Copy/util.hpp>
+#include <El/blas_like/level1/Copy/SharedMemory.hpp>
 
 namespace El {
 
@@ -589,4 +590,6 @@ void CopyFromNonRoot( const DistMultiVec<T>& XDist, int root )
 
 } // namespace El
 
+#include <El/blas_like/level1/Copy/Async.hpp>
+
 #endif // ifndef EL_BLAS_COPY_HPP
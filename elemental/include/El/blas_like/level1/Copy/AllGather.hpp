@@ -12,6 +12,59 @@
 namespace El {
 namespace copy {
 
+// Gather through the node's shared-memory window (see shared::AllGather)
+template<typename T,Dist U,Dist V,typename=EnableIf<IsPacked<T>>>
+bool SharedAllGather
+( const DistMatrix<T,        U,           V   >& A,
+        DistMatrix<T,Collect<U>(),Collect<V>()>& B,
+  Int portionSize )
+{
+    EL_DEBUG_CSE
+    const Int height = A.Height();
+    const Int width = A.Width();
+    const Int colStride = A.ColStride();
+    const Int rowStride = A.RowStride();
+    auto pack = [&]( T* portion )
+      {
+          util::InterleaveMatrix
+          ( A.LocalHeight(), A.LocalWidth(),
+            A.LockedBuffer(), 1, A.LDim(),
+            portion,          1, A.LocalHeight() );
+      };
+    auto unpack = [&]( const T* portions, const shared::NodeContext& context )
+      {
+          // The portions are in node-major rather than rank order
+          T* BBuf = B.Buffer();
+          const Int BLDim = B.LDim();
+          for( Int l=0; l<rowStride; ++l )
+          {
+              const Int rowShift = Shift_( l, A.RowAlign(), rowStride );
+              const Int localWidth = Length_( width, rowShift, rowStride );
+              for( Int k=0; k<colStride; ++k )
+              {
+                  const Int colShift = Shift_( k, A.ColAlign(), colStride );
+                  const Int localHeight =
+                    Length_( height, colShift, colStride );
+                  const Int slot = context.slots[k+l*colStride];
+                  util::InterleaveMatrix
+                  ( localHeight, localWidth,
+                    &portions[slot*portionSize], 1, localHeight,
+                    &BBuf[colShift+rowShift*BLDim],
+                    colStride, rowStride*BLDim );
+              }
+          }
+      };
+    return shared::AllGather<T>( portionSize, A.DistComm(), pack, unpack );
+}
+
+template<typename T,Dist U,Dist V,typename=DisableIf<IsPacked<T>>,
+         typename=void>
+bool SharedAllGather
+( const DistMatrix<T,        U,           V   >&,
+        DistMatrix<T,Collect<U>(),Collect<V>()>&,
+  Int )
+{ return false; }
+
 template<typename T,Dist U,Dist V>
 void AllGather
 ( const DistMatrix<T,        U,           V   >& A,
@@ -27,18 +80,23 @@ void AllGather
 
     if( A.Participating() )
     {
+        const Int colStride = A.ColStride();
+        const Int rowStride = A.RowStride();
+        const Int distStride = colStride*rowStride;
+        const Int maxLocalHeight = MaxLength(height,colStride);
+        const Int maxLocalWidth = MaxLength(width,rowStride);
+        const Int portionSize = mpi::Pad( maxLocalHeight*maxLocalWidth );
         if( A.DistSize() == 1 )
         {
             Copy( A.LockedMatrix(), B.Matrix() );
         }
+        else if( SharedMemoryRedist() &&
+                 SharedAllGather( A, B, portionSize ) )
+        {
+            // The gather went through the node's shared memory
+        }
         else
         {
-            const Int colStride = A.ColStride();
-            const Int rowStride = A.RowStride();
-            const Int distStride = colStride*rowStride;
-            const Int maxLocalHeight = MaxLength(height,colStride);
-            const Int maxLocalWidth = MaxLength(width,rowStride);
-            const Int portionSize = mpi::Pad( maxLocalHeight*maxLocalWidth );
             vector<T> buf;
             FastResize( buf, (distStride+1)*portionSize );
             T* sendBuf = &buf[0];
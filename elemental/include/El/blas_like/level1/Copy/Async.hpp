@@ -0,0 +1,237 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_BLAS_COPY_ASYNC_HPP
+#define EL_BLAS_COPY_ASYNC_HPP
+
+namespace El {
+
+// A handle for a nonblocking redistribution started by ICopy
+// ==========================================================
+// The communication buffer is retained between redistributions so that
+// repeatedly redistributing panels of the same shape (e.g., within a blocked
+// factorization) does not reallocate it. When MPI-4 persistent collectives
+// are available, the persistent all-gather is also reused for as long as the
+// communicator, message size, and buffer are unchanged.
+template<typename T>
+class CopyRequest
+{
+public:
+    CopyRequest() { }
+    ~CopyRequest();
+
+    CopyRequest( const CopyRequest<T>& ) = delete;
+    const CopyRequest<T>& operator=( const CopyRequest<T>& ) = delete;
+
+    // Start redistributing A into B (see ICopy)
+    void Start( const ElementalMatrix<T>& A, ElementalMatrix<T>& B );
+
+    // Returns true (after unpacking into B) if the redistribution finished
+    bool Test();
+    // Block until the redistribution has finished and unpack into B
+    void Wait();
+
+    bool Active() const EL_NO_EXCEPT { return active_; }
+
+private:
+    bool active_=false;
+    bool colGather_=false;
+    ElementalMatrix<T>* B_=nullptr;
+    Int height_=0, width_=0;
+    Int align_=0, stride_=1;
+    Int portionSize_=0;
+    vector<T> buffer_;
+    mpi::Request<T> request_;
+
+#if MPI_VERSION >= 4
+    bool havePersistent_=false;
+    MPI_Comm persistentComm_;
+    Int persistentSize_=0;
+    T* persistentBuf_=nullptr;
+
+    void FreePersistent();
+#endif
+
+    void Communicate( mpi::Comm comm );
+    void Unpack();
+};
+
+template<typename T>
+CopyRequest<T>::~CopyRequest()
+{
+    if( active_ )
+    {
+        try { Wait(); }
+        catch( std::exception& e ) { ReportException(e); }
+    }
+#if MPI_VERSION >= 4
+    FreePersistent();
+#endif
+}
+
+#if MPI_VERSION >= 4
+template<typename T>
+void CopyRequest<T>::FreePersistent()
+{
+    if( havePersistent_ )
+    {
+        MPI_Request_free( &request_.backend );
+        havePersistent_ = false;
+    }
+}
+#endif
+
+template<typename T>
+void CopyRequest<T>::Communicate( mpi::Comm comm )
+{
+    EL_DEBUG_CSE
+    T* sendBuf = &buffer_[0];
+    T* recvBuf = &buffer_[portionSize_];
+#if MPI_VERSION >= 4
+    if( IsPacked<T>::value )
+    {
+        if( !havePersistent_ || persistentComm_ != comm.comm ||
+            persistentSize_ != portionSize_ || persistentBuf_ != sendBuf )
+        {
+            FreePersistent();
+            MPI_Allgather_init
+            ( sendBuf, portionSize_, mpi::TypeMap<T>(),
+              recvBuf, portionSize_, mpi::TypeMap<T>(),
+              comm.comm, MPI_INFO_NULL, &request_.backend );
+            request_.receivingPacked = false;
+            havePersistent_ = true;
+            persistentComm_ = comm.comm;
+            persistentSize_ = portionSize_;
+            persistentBuf_ = sendBuf;
+        }
+        MPI_Start( &request_.backend );
+        return;
+    }
+#endif
+    mpi::IAllGather
+    ( sendBuf, portionSize_, recvBuf, portionSize_, comm, request_ );
+}
+
+template<typename T>
+void CopyRequest<T>::Start
+( const ElementalMatrix<T>& A, ElementalMatrix<T>& B )
+{
+    EL_DEBUG_CSE
+    if( active_ )
+        LogicError("The previous redistribution has not yet completed");
+    AssertSameGrids( A, B );
+    const Int height = A.Height();
+    const Int width = A.Width();
+
+    const bool colGather =
+      B.ColDist() == Collect(A.ColDist()) && B.RowDist() == A.RowDist() &&
+      A.ColStride() > 1 && height > 1;
+    const bool rowGather =
+      B.ColDist() == A.ColDist() && B.RowDist() == Collect(A.RowDist()) &&
+      A.RowStride() > 1 && width > 1;
+    if( (colGather || rowGather) && A.CrossComm() == mpi::COMM_SELF )
+    {
+        bool aligned;
+        if( colGather )
+        {
+            B.AlignRowsAndResize( A.RowAlign(), height, width, false, false );
+            aligned = ( B.RowAlign() == A.RowAlign() );
+        }
+        else
+        {
+            B.AlignColsAndResize( A.ColAlign(), height, width, false, false );
+            aligned = ( B.ColAlign() == A.ColAlign() );
+        }
+        if( aligned )
+        {
+            if( !A.Participating() )
+                return;
+            const Int localHeight = A.LocalHeight();
+            const Int localWidth = A.LocalWidth();
+            colGather_ = colGather;
+            B_ = &B;
+            height_ = ( colGather ? height : localHeight );
+            width_ = ( colGather ? localWidth : width );
+            align_ = ( colGather ? A.ColAlign() : A.RowAlign() );
+            stride_ = ( colGather ? A.ColStride() : A.RowStride() );
+            portionSize_ =
+              ( colGather ?
+                mpi::Pad( MaxLength(height,stride_)*localWidth ) :
+                mpi::Pad( localHeight*MaxLength(width,stride_) ) );
+            const Int bufferSize = (stride_+1)*portionSize_;
+            if( Int(buffer_.size()) < bufferSize )
+                FastResize( buffer_, bufferSize );
+
+            // Pack
+            copy::util::InterleaveMatrix
+            ( localHeight, localWidth,
+              A.LockedBuffer(), 1, A.LDim(),
+              buffer_.data(),   1, localHeight );
+
+            Communicate( colGather ? A.ColComm() : A.RowComm() );
+            active_ = true;
+            return;
+        }
+    }
+
+    // Fall back to a blocking redistribution
+    Copy( A, B );
+}
+
+template<typename T>
+void CopyRequest<T>::Unpack()
+{
+    EL_DEBUG_CSE
+    const T* recvBuf = &buffer_[portionSize_];
+    if( colGather_ )
+        copy::util::ColStridedUnpack
+        ( height_, width_, align_, stride_,
+          recvBuf, portionSize_,
+          B_->Buffer(), B_->LDim() );
+    else
+        copy::util::RowStridedUnpack
+        ( height_, width_, align_, stride_,
+          recvBuf, portionSize_,
+          B_->Buffer(), B_->LDim() );
+    active_ = false;
+    B_ = nullptr;
+}
+
+template<typename T>
+bool CopyRequest<T>::Test()
+{
+    EL_DEBUG_CSE
+    if( !active_ )
+        return true;
+    if( !mpi::Test( request_ ) )
+        return false;
+    Unpack();
+    return true;
+}
+
+template<typename T>
+void CopyRequest<T>::Wait()
+{
+    EL_DEBUG_CSE
+    if( !active_ )
+        return;
+    mpi::Wait( request_ );
+    Unpack();
+}
+
+template<typename T>
+void ICopy
+( const ElementalMatrix<T>& A, ElementalMatrix<T>& B, CopyRequest<T>& request )
+{
+    EL_DEBUG_CSE
+    request.Start( A, B );
+}
+
+} // namespace El
+
+#endif // ifndef EL_BLAS_COPY_ASYNC_HPP
@@ -12,15 +12,47 @@
 namespace El {
 namespace copy {
 
+inline Int& RedistMemoryLimitRef()
+{
+    static Int maxBytes = Int(1) << 28;
+    return maxBytes;
+}
+
+} // namespace copy
+
+inline void SetRedistMemoryLimit( Int bytes )
+{
+    if( bytes <= 0 )
+        LogicError("The redistribution memory limit must be positive");
+    copy::RedistMemoryLimitRef() = bytes;
+}
+inline Int RedistMemoryLimit() { return copy::RedistMemoryLimitRef(); }
+
+namespace copy {
+
+// Entries are transmitted using the narrower of the source and target types;
+// since the entries are eventually cast to the target type either way, this
+// does not change the result
+template<typename S,typename T>
+using WireType = typename std::conditional<(sizeof(T)<sizeof(S)),T,S>::type;
+
+// The general-purpose redistribution proceeds over panels of consecutive
+// global columns, each of which is sized so that a process with its share of
+// the entries sends at most RedistMemoryLimit() bytes per round.
+//
+// When both matrices live on the same grid, only the values are sent: since
+// the global indices of both the element and block distributions increase
+// with the local indices, each process can recompute the order in which the
+// owner of each of its entries packed them (column-major in the global
+// indices) and no indices need to be transmitted. Redistributions between
+// different grids continue to send (i,j,value) triplets.
 template<typename S,typename T,typename=EnableIf<CanCast<S,T>>>
 void Helper
 ( const AbstractDistMatrix<S>& A,
         AbstractDistMatrix<T>& B )
 {
     EL_DEBUG_CSE
-
-    // TODO: Decide whether S or T should be used as the transmission type
-    //       based upon which is smaller. Transmit S by default.
+    typedef WireType<S,T> W;
     const Int height = A.Height();
     const Int width = A.Width();
     const Grid& g = B.Grid();
@@ -30,144 +62,220 @@ void Helper
     const int BRoot = B.Root();
 
     const bool includeViewers = (A.Grid() != B.Grid());
+    if( !includeViewers && !g.InGrid() )
+        return;
 
     const Int localHeight = A.LocalHeight();
     const Int localWidth = A.LocalWidth();
     auto& ALoc = A.LockedMatrix();
     auto& BLoc = B.Matrix();
 
-    // TODO: Break into smaller pieces to avoid excessive memory usage?
-    vector<Entry<S>> remoteEntries;
-    vector<int> distOwners;
-    if( A.RedundantRank() == 0 )
+    // We will first push to redundant rank 0 of B
+    const int redundantRootB = 0;
+    const bool sending = ( A.RedundantRank() == 0 );
+    const bool receiving = ( BPartic && B.RedundantRank() == redundantRootB );
+    const bool noRedundant = B.RedundantSize() == 1;
+    const int colStrideB = B.ColStride();
+    const int rowRankB = B.RowRank();
+    const int colRankB = B.ColRank();
+
+    // Map the distribution ranks of B (and, when only values are sent, of A)
+    // to ranks in the communicator used for the exchange
+    // ======================================================================
+    mpi::Comm comm = ( includeViewers ? g.ViewingComm() : g.VCComm() );
+    const int commSize = mpi::Size( comm );
+    const int commRank = mpi::Rank( comm );
+    const int distBSize = mpi::Size( B.DistComm() );
+    vector<int> distBToComm(distBSize);
+    for( int distBRank=0; distBRank<distBSize; ++distBRank )
+    {
+        const int vcOwner =
+          g.CoordsToVC
+          (B.ColDist(),B.RowDist(),distBRank,BRoot,redundantRootB);
+        distBToComm[distBRank] =
+          ( includeViewers ? g.VCToViewing(vcOwner) : vcOwner );
+    }
+    vector<int> distAToComm;
+    if( !includeViewers )
     {
-        const bool noRedundant = B.RedundantSize() == 1;
-        const int colStride = B.ColStride();
-        const int rowRank = B.RowRank();
-        const int colRank = B.ColRank();
+        const int distASize = mpi::Size( A.DistComm() );
+        distAToComm.resize( distASize );
+        for( int distARank=0; distARank<distASize; ++distARank )
+            distAToComm[distARank] =
+              g.CoordsToVC(A.ColDist(),A.RowDist(),distARank,A.Root(),0);
+    }
 
-        vector<Int> globalRows(localHeight), localRows(localHeight);
-        vector<int> ownerRows(localHeight);
+    // Precompute the row metadata of the entries we send
+    // ==================================================
+    vector<Int> localRows, globalColsA;
+    vector<int> ownerRows;
+    if( sending )
+    {
+        localRows.resize( localHeight );
+        ownerRows.resize( localHeight );
         for( Int iLoc=0; iLoc<localHeight; ++iLoc )
         {
             const Int i = A.GlobalRow(iLoc);
             const int ownerRow = B.RowOwner(i);
-            globalRows[iLoc] = i;
             ownerRows[iLoc] = ownerRow;
             localRows[iLoc] = B.LocalRow(i,ownerRow);
         }
-
-        remoteEntries.reserve( localHeight*localWidth );
-        distOwners.reserve( localHeight*localWidth );
+        globalColsA.resize( localWidth );
         for( Int jLoc=0; jLoc<localWidth; ++jLoc )
-        {
-            const Int j = A.GlobalCol(jLoc);
-            const int ownerCol = B.ColOwner(j);
-            const Int localCol = B.LocalCol(j,ownerCol);
-            const bool isLocalCol = ( BPartic && ownerCol == rowRank );
-            for( Int iLoc=0; iLoc<localHeight; ++iLoc )
-            {
-                const int ownerRow = ownerRows[iLoc];
-                const Int localRow = localRows[iLoc];
-                const bool isLocalRow = ( BPartic && ownerRow == colRank );
-                const S& alpha = ALoc(iLoc,jLoc);
-                if( noRedundant && isLocalRow && isLocalCol )
-                {
-                    BLoc(localRow,localCol) = Caster<S,T>::Cast(alpha);
-                }
-                else
-                {
-                    remoteEntries.push_back
-                    ( Entry<S>{localRow,localCol,alpha} );
-                    distOwners.push_back( ownerRow + colStride*ownerCol );
-                }
-            }
-        }
+            globalColsA[jLoc] = A.GlobalCol(jLoc);
     }
 
-    // We will first push to redundant rank 0 of B
-    const int redundantRootB = 0;
+    // ...and of the entries we receive (only needed when sending values)
+    // ==================================================================
+    vector<int> sourceRows;
+    vector<Int> globalColsB;
+    const bool unpackValues = ( !includeViewers && receiving );
+    if( unpackValues )
+    {
+        const Int localHeightB = B.LocalHeight();
+        const Int localWidthB = B.LocalWidth();
+        sourceRows.resize( localHeightB );
+        for( Int iLoc=0; iLoc<localHeightB; ++iLoc )
+            sourceRows[iLoc] = A.RowOwner( B.GlobalRow(iLoc) );
+        globalColsB.resize( localWidthB );
+        for( Int jLoc=0; jLoc<localWidthB; ++jLoc )
+            globalColsB[jLoc] = B.GlobalCol(jLoc);
+    }
 
-    // Compute the metadata
-    // ====================
-    const Int totalSend = remoteEntries.size();
-    mpi::Comm comm;
-    vector<int> sendCounts, owners(totalSend);
-    if( includeViewers )
+    // Choose the panel width
+    // ======================
+    const double entrySize =
+      ( includeViewers ? sizeof(Entry<W>) : sizeof(W) );
+    const double minDistSize = Min( A.DistSize(), B.DistSize() );
+    Int panelWidth = width;
+    if( height > 0 )
     {
-        comm = g.ViewingComm();
-        const int viewingSize = mpi::Size( g.ViewingComm() );
-        const int distBSize = mpi::Size( B.DistComm() );
+        const double maxPanelWidth =
+          double(RedistMemoryLimit())*minDistSize/(height*entrySize);
+        if( maxPanelWidth < double(width) )
+            panelWidth = Max( Int(maxPanelWidth), Int(1) );
+    }
+    const Int numRounds =
+      ( width == 0 ? 0 : (width+panelWidth-1)/panelWidth );
 
-        vector<int> distBToViewing(distBSize);
-        for( int distBRank=0; distBRank<distBSize; ++distBRank )
+    vector<int> sendCounts(commSize), sendOffs, recvCounts, recvOffs;
+    vector<W> sendValues, recvValues;
+    vector<Entry<W>> sendEntries;
+    Int jLocBegA=0, jLocBegB=0;
+    for( Int round=0; round<numRounds; ++round )
+    {
+        const Int jEnd = Min( (round+1)*panelWidth, width );
+        Int jLocEndA = jLocBegA;
+        if( sending )
+            while( jLocEndA < localWidth && globalColsA[jLocEndA] < jEnd )
+                ++jLocEndA;
+
+        // Count the entries we send to each process
+        // -----------------------------------------
+        // Entries we own in B are stored immediately
+        std::fill( sendCounts.begin(), sendCounts.end(), 0 );
+        for( Int jLoc=jLocBegA; jLoc<jLocEndA; ++jLoc )
         {
-            const int vcOwner =
-              g.CoordsToVC
-              (B.ColDist(),B.RowDist(),distBRank,BRoot,redundantRootB);
-            distBToViewing[distBRank] = g.VCToViewing(vcOwner);
+            const int ownerCol = B.ColOwner(globalColsA[jLoc]);
+            const int ownerBase = colStrideB*ownerCol;
+            const bool isLocalCol = ( BPartic && ownerCol == rowRankB );
+            for( Int iLoc=0; iLoc<localHeight; ++iLoc )
+            {
+                const int owner = distBToComm[ownerRows[iLoc]+ownerBase];
+                const bool isLocal =
+                  ( includeViewers ?
+                    noRedundant && isLocalCol && ownerRows[iLoc] == colRankB :
+                    owner == commRank );
+                if( !isLocal )
+                    ++sendCounts[owner];
+            }
         }
+        const Int totalSend = Scan( sendCounts, sendOffs );
 
-        sendCounts.resize(viewingSize,0);
-        for( Int k=0; k<totalSend; ++k )
+        // Pack the data
+        // -------------
+        if( includeViewers )
+            FastResize( sendEntries, totalSend );
+        else
+            FastResize( sendValues, totalSend );
+        auto offs = sendOffs;
+        for( Int jLoc=jLocBegA; jLoc<jLocEndA; ++jLoc )
         {
-            owners[k] = distBToViewing[distOwners[k]];
-            ++sendCounts[owners[k]];
+            const int ownerCol = B.ColOwner(globalColsA[jLoc]);
+            const int ownerBase = colStrideB*ownerCol;
+            const Int localCol = B.LocalCol(globalColsA[jLoc],ownerCol);
+            const bool isLocalCol = ( BPartic && ownerCol == rowRankB );
+            for( Int iLoc=0; iLoc<localHeight; ++iLoc )
+            {
+                const int owner = distBToComm[ownerRows[iLoc]+ownerBase];
+                const bool isLocal =
+                  ( includeViewers ?
+                    noRedundant && isLocalCol && ownerRows[iLoc] == colRankB :
+                    owner == commRank );
+                const S& alpha = ALoc(iLoc,jLoc);
+                if( isLocal )
+                    BLoc(localRows[iLoc],localCol) = Caster<S,T>::Cast(alpha);
+                else if( includeViewers )
+                    sendEntries[offs[owner]++] =
+                      Entry<W>
+                      {localRows[iLoc],localCol,Caster<S,W>::Cast(alpha)};
+                else
+                    sendValues[offs[owner]++] = Caster<S,W>::Cast(alpha);
+            }
         }
-    }
-    else
-    {
-        if( !g.InGrid() )
-            return;
-        comm = g.VCComm();
+        jLocBegA = jLocEndA;
 
-        const int distBSize = mpi::Size( B.DistComm() );
-        vector<int> distBToVC(distBSize);
-        for( int distBRank=0; distBRank<distBSize; ++distBRank )
+        // Exchange and unpack the data
+        // ----------------------------
+        if( includeViewers )
         {
-            distBToVC[distBRank] =
-              g.CoordsToVC
-              (B.ColDist(),B.RowDist(),distBRank,BRoot,redundantRootB);
+            auto recvEntries =
+              mpi::AllToAll( sendEntries, sendCounts, sendOffs, comm );
+            if( receiving )
+                for( const auto& entry : recvEntries )
+                    BLoc(entry.i,entry.j) = Caster<W,T>::Cast(entry.value);
+            continue;
         }
 
-        const int vcSize = mpi::Size( g.VCComm() );
-        sendCounts.resize(vcSize,0);
-        for( Int k=0; k<totalSend; ++k )
+        // Each process determines its receive counts from A's distribution
+        const Int localHeightB = sourceRows.size();
+        const Int localWidthB = globalColsB.size();
+        Int jLocEndB = jLocBegB;
+        while( jLocEndB < localWidthB && globalColsB[jLocEndB] < jEnd )
+            ++jLocEndB;
+        recvCounts.assign( commSize, 0 );
+        const int colStrideA = A.ColStride();
+        for( Int jLoc=jLocBegB; jLoc<jLocEndB; ++jLoc )
         {
-            owners[k] = distBToVC[distOwners[k]];
-            ++sendCounts[owners[k]];
+            const int sourceBase = colStrideA*A.ColOwner(globalColsB[jLoc]);
+            for( Int iLoc=0; iLoc<localHeightB; ++iLoc )
+            {
+                const int source = distAToComm[sourceRows[iLoc]+sourceBase];
+                if( source != commRank )
+                    ++recvCounts[source];
+            }
         }
-    }
-    SwapClear( distOwners );
-
-    // Pack the data
-    // =============
-    vector<int> sendOffs;
-    Scan( sendCounts, sendOffs );
-    vector<Entry<S>> sendBuf;
-    FastResize( sendBuf, totalSend );
-    auto offs = sendOffs;
-    for( Int k=0; k<totalSend; ++k )
-        sendBuf[offs[owners[k]]++] = remoteEntries[k];
-    SwapClear( remoteEntries );
-    SwapClear( owners );
-
-    // Exchange and unpack the data
-    // ============================
-    auto recvBuf = mpi::AllToAll( sendBuf, sendCounts, sendOffs, comm );
-    if( BPartic )
-    {
-        if( B.RedundantRank() == redundantRootB )
+        const Int totalRecv = Scan( recvCounts, recvOffs );
+        FastResize( recvValues, totalRecv );
+        mpi::AllToAll
+        ( sendValues.data(), sendCounts.data(), sendOffs.data(),
+          recvValues.data(), recvCounts.data(), recvOffs.data(), comm );
+        offs = recvOffs;
+        for( Int jLoc=jLocBegB; jLoc<jLocEndB; ++jLoc )
         {
-            Int recvBufSize = recvBuf.size();
-            for( Int k=0; k<recvBufSize; ++k )
+            const int sourceBase = colStrideA*A.ColOwner(globalColsB[jLoc]);
+            for( Int iLoc=0; iLoc<localHeightB; ++iLoc )
             {
-                const auto& entry = recvBuf[k];
-                BLoc(entry.i,entry.j) = Caster<S,T>::Cast(entry.value);
+                const int source = distAToComm[sourceRows[iLoc]+sourceBase];
+                if( source != commRank )
+                    BLoc(iLoc,jLoc) =
+                      Caster<W,T>::Cast(recvValues[offs[source]++]);
             }
         }
-        El::Broadcast( B, B.RedundantComm(), redundantRootB );
+        jLocBegB = jLocEndB;
     }
+    if( BPartic )
+        El::Broadcast( B, B.RedundantComm(), redundantRootB );
 }
 
 template<typename S,typename T,typename>
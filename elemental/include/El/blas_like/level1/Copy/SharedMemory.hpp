@@ -0,0 +1,236 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_BLAS_COPY_SHAREDMEMORY_HPP
+#define EL_BLAS_COPY_SHAREDMEMORY_HPP
+
+namespace El {
+
+namespace copy {
+
+inline bool& SharedMemoryRedistRef()
+{
+    static bool enabled = false;
+    return enabled;
+}
+
+} // namespace copy
+
+inline void SetSharedMemoryRedist( bool enable )
+{ copy::SharedMemoryRedistRef() = enable; }
+inline bool SharedMemoryRedist() { return copy::SharedMemoryRedistRef(); }
+
+namespace copy {
+namespace shared {
+
+// The node-level view of a communicator
+// =====================================
+// The processes of the communicator which share a node are ordered
+// node-by-node ("node-major" order), so that each node's portion of a
+// node-major buffer is contiguous. The node's leader (its first process)
+// owns a window of memory which is shared by all of the processes on the
+// node and which is grown as needed.
+//
+// The context is cached as an attribute of the communicator, so that it is
+// released along with it.
+struct NodeContext
+{
+    mpi::Comm nodeComm;
+    mpi::Comm leaderComm=mpi::COMM_NULL; // only valid on the node leaders
+    int nodeRank, nodeSize, numNodes;
+    // The largest number of processes on any one node (the same on every
+    // process of the communicator)
+    int maxNodeSize;
+    // The node-major position of each rank of the communicator
+    vector<int> slots;
+    // The number of processes on, and the first slot of, each node
+    vector<int> nodeSizes, nodeOffsets;
+
+    MPI_Win window=MPI_WIN_NULL;
+    byte* buffer=nullptr;
+    size_t capacity=0;
+};
+
+inline void FreeWindow( NodeContext& context )
+{
+    if( context.window != MPI_WIN_NULL )
+    {
+        MPI_Win_unlock_all( context.window );
+        MPI_Win_free( &context.window );
+        context.buffer = nullptr;
+        context.capacity = 0;
+    }
+}
+
+inline int DeleteContext
+( MPI_Comm /*comm*/, int /*keyval*/, void* attribute, void* /*extraState*/ )
+{
+    auto context = static_cast<NodeContext*>(attribute);
+    FreeWindow( *context );
+    if( context->leaderComm != mpi::COMM_NULL )
+        mpi::Free( context->leaderComm );
+    mpi::Free( context->nodeComm );
+    delete context;
+    return MPI_SUCCESS;
+}
+
+inline int Keyval()
+{
+    static int keyval = MPI_KEYVAL_INVALID;
+    if( keyval == MPI_KEYVAL_INVALID )
+        MPI_Comm_create_keyval
+        ( MPI_COMM_NULL_COPY_FN, DeleteContext, &keyval, nullptr );
+    return keyval;
+}
+
+inline NodeContext& Context( mpi::Comm comm )
+{
+    EL_DEBUG_CSE
+    void* attribute;
+    int found;
+    MPI_Comm_get_attr( comm.comm, Keyval(), &attribute, &found );
+    if( found )
+        return *static_cast<NodeContext*>(attribute);
+
+    auto context = new NodeContext;
+    const int commRank = mpi::Rank( comm );
+    const int commSize = mpi::Size( comm );
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type
+    ( comm.comm, MPI_COMM_TYPE_SHARED, commRank, MPI_INFO_NULL, &nodeComm );
+    context->nodeComm = nodeComm;
+    context->nodeRank = mpi::Rank( context->nodeComm );
+    context->nodeSize = mpi::Size( context->nodeComm );
+    const bool leader = ( context->nodeRank == 0 );
+    mpi::Split
+    ( comm, (leader ? 0 : MPI_UNDEFINED), commRank, context->leaderComm );
+
+    // Order the nodes by the ranks of their leaders
+    int nodeInfo[2] = { 0, 0 };
+    if( leader )
+    {
+        nodeInfo[0] = mpi::Rank( context->leaderComm );
+        nodeInfo[1] = mpi::Size( context->leaderComm );
+    }
+    mpi::Broadcast( nodeInfo, 2, 0, context->nodeComm );
+    const int nodeIndex = nodeInfo[0];
+    context->numNodes = nodeInfo[1];
+    context->nodeSizes.resize( context->numNodes );
+    if( leader )
+        mpi::AllGather
+        ( &context->nodeSize, 1,
+          context->nodeSizes.data(), 1, context->leaderComm );
+    mpi::Broadcast
+    ( context->nodeSizes.data(), context->numNodes, 0, context->nodeComm );
+    context->nodeOffsets.resize( context->numNodes );
+    Scan( context->nodeSizes, context->nodeOffsets );
+    context->maxNodeSize =
+      mpi::AllReduce( context->nodeSize, mpi::MAX, comm );
+
+    const int slot = context->nodeOffsets[nodeIndex] + context->nodeRank;
+    context->slots.resize( commSize );
+    mpi::AllGather( &slot, 1, context->slots.data(), 1, comm );
+
+    MPI_Comm_set_attr( comm.comm, Keyval(), context );
+    return *context;
+}
+
+// Ensure that the node's window holds at least 'numBytes' bytes
+// (this is collective over the node)
+inline void Reserve( NodeContext& context, size_t numBytes )
+{
+    EL_DEBUG_CSE
+    if( numBytes <= context.capacity )
+        return;
+    FreeWindow( context );
+    const size_t localBytes = ( context.nodeRank == 0 ? numBytes : 0 );
+    void* localBuffer;
+    MPI_Win_allocate_shared
+    ( localBytes, 1, MPI_INFO_NULL, context.nodeComm.comm,
+      &localBuffer, &context.window );
+    MPI_Aint leaderBytes;
+    int dispUnit;
+    void* leaderBuffer;
+    MPI_Win_shared_query
+    ( context.window, 0, &leaderBytes, &dispUnit, &leaderBuffer );
+    context.buffer = static_cast<byte*>(leaderBuffer);
+    context.capacity = numBytes;
+    // A single passive-target epoch is kept open for the lifetime of the
+    // window; accesses are ordered with Synchronize
+    MPI_Win_lock_all( MPI_MODE_NOCHECK, context.window );
+}
+
+// Make the local writes to the window visible to the rest of the node (and
+// vice versa)
+inline void Synchronize( NodeContext& context )
+{
+    MPI_Win_sync( context.window );
+    mpi::Barrier( context.nodeComm );
+    MPI_Win_sync( context.window );
+}
+
+// A hierarchical all-gather of equal-sized portions
+// =================================================
+// Each process writes its portion directly into the node's shared buffer, the
+// node leaders exchange their nodes' contiguous blocks over the network, and
+// the result is then read in place by every process on the node. Only one
+// copy of the gathered portions is kept per node, and no intra-node traffic
+// goes through MPI.
+//
+// Returns false (having done nothing) if no node holds multiple processes of
+// the communicator, in which case there is nothing to gain. The decision is
+// made identically on every process so that all of them either take part in
+// the shared-memory gather or fall back to MPI together.
+// Otherwise 'unpack' is called with the node-major buffer of portions and the
+// shared context, after which the buffer may be overwritten.
+template<typename T,typename PackFunctor,typename UnpackFunctor>
+bool AllGather
+( Int portionSize, mpi::Comm comm,
+  PackFunctor pack, UnpackFunctor unpack )
+{
+    EL_DEBUG_CSE
+    const size_t portionBytes = portionSize*sizeof(T);
+    if( portionBytes > size_t(std::numeric_limits<int>::max()) )
+        return false;
+    auto& context = Context( comm );
+    if( context.maxNodeSize == 1 )
+        return false;
+
+    const int commSize = mpi::Size( comm );
+    Reserve( context, commSize*portionBytes );
+    T* portions = reinterpret_cast<T*>(context.buffer);
+
+    pack( &portions[context.slots[mpi::Rank(comm)]*portionSize] );
+    Synchronize( context );
+
+    if( context.numNodes > 1 && context.nodeRank == 0 )
+    {
+        MPI_Datatype portionType;
+        MPI_Type_contiguous( int(portionBytes), MPI_BYTE, &portionType );
+        MPI_Type_commit( &portionType );
+        MPI_Allgatherv
+        ( MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+          portions, context.nodeSizes.data(), context.nodeOffsets.data(),
+          portionType, context.leaderComm.comm );
+        MPI_Type_free( &portionType );
+    }
+    Synchronize( context );
+
+    unpack( const_cast<const T*>(portions), context );
+
+    // Do not allow the buffer to be overwritten until the entire node has
+    // finished reading from it
+    mpi::Barrier( context.nodeComm );
+    return true;
+}
+
+} // namespace shared
+} // namespace copy
+} // namespace El
+
+#endif // ifndef EL_BLAS_COPY_SHAREDMEMORY_HPP
@@ -30,6 +30,51 @@ template<typename T>
 void EntrywiseFill( DistMultiVec<T>& A, function<T(void)> func )
 { EntrywiseFill( A.Matrix(), func ); }
 
+// Parallel variant for arbitrary functors
+// =======================================
+// This is instantiated for each functor type so that the functor can be
+// inlined into a threaded, vectorized loop. Since the functor is called
+// concurrently, it must be thread-safe (e.g., a random number generator
+// should be keyed by index rather than share a single state); the variant is
+// therefore opt-in, and a lambda passed to EntrywiseFill is still called
+// serially through an El::function.
+
+template<typename T,typename Functor>
+void EntrywiseFillParallel( Matrix<T>& A, Functor func )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    T* EL_RESTRICT ABuf = A.Buffer();
+    const Int ALDim = A.LDim();
+    if( ALDim == m )
+    {
+        const Int size = m*n;
+        EL_PARALLEL_FOR_SIMD
+        for( Int k=0; k<size; ++k )
+            ABuf[k] = func();
+    }
+    else
+    {
+        EL_PARALLEL_FOR
+        for( Int j=0; j<n; ++j )
+        {
+            T* EL_RESTRICT aCol = &ABuf[j*ALDim];
+            EL_SIMD
+            for( Int i=0; i<m; ++i )
+                aCol[i] = func();
+        }
+    }
+}
+
+template<typename T,typename Functor>
+void EntrywiseFillParallel( AbstractDistMatrix<T>& A, Functor func )
+{ EntrywiseFillParallel( A.Matrix(), func ); }
+
+template<typename T,typename Functor>
+void EntrywiseFillParallel( DistMultiVec<T>& A, Functor func )
+{ EntrywiseFillParallel( A.Matrix(), func ); }
+
 #ifdef EL_INSTANTIATE_BLAS_LEVEL1
 # define EL_EXTERN
 #else
@@ -175,6 +175,205 @@ void EntrywiseMap
     EntrywiseMap( A.LockedMatrix(), B.Matrix(), func );
 }
 
+// Parallel variants for arbitrary functors
+// ========================================
+// Unlike the above routines, which accept an El::function and are explicitly
+// instantiated, the following are instantiated for each functor type (e.g.,
+// a lambda) so that the functor can be inlined into loops which OpenMP can
+// both thread and vectorize. The functor is called concurrently and must
+// therefore be thread-safe, which is why these variants have their own name
+// rather than overloading EntrywiseMap.
+
+template<typename T,typename Functor>
+void EntrywiseMapParallel( Matrix<T>& A, Functor func )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    T* EL_RESTRICT ABuf = A.Buffer();
+    const Int ALDim = A.LDim();
+    if( ALDim == m )
+    {
+        const Int size = m*n;
+        EL_PARALLEL_FOR_SIMD
+        for( Int k=0; k<size; ++k )
+            ABuf[k] = func(ABuf[k]);
+    }
+    else
+    {
+        EL_PARALLEL_FOR
+        for( Int j=0; j<n; ++j )
+        {
+            T* EL_RESTRICT aCol = &ABuf[j*ALDim];
+            EL_SIMD
+            for( Int i=0; i<m; ++i )
+                aCol[i] = func(aCol[i]);
+        }
+    }
+}
+
+template<typename T,typename Functor>
+void EntrywiseMapParallel( AbstractDistMatrix<T>& A, Functor func )
+{ EntrywiseMapParallel( A.Matrix(), func ); }
+
+template<typename T,typename Functor>
+void EntrywiseMapParallel( DistMultiVec<T>& A, Functor func )
+{ EntrywiseMapParallel( A.Matrix(), func ); }
+
+template<typename S,typename T,typename Functor>
+void EntrywiseMapParallel( const Matrix<S>& A, Matrix<T>& B, Functor func )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    B.Resize( m, n );
+    const S* EL_RESTRICT ABuf = A.LockedBuffer();
+          T* EL_RESTRICT BBuf = B.Buffer();
+    const Int ALDim = A.LDim();
+    const Int BLDim = B.LDim();
+    if( ALDim == m && BLDim == m )
+    {
+        const Int size = m*n;
+        EL_PARALLEL_FOR_SIMD
+        for( Int k=0; k<size; ++k )
+            BBuf[k] = func(ABuf[k]);
+    }
+    else
+    {
+        EL_PARALLEL_FOR
+        for( Int j=0; j<n; ++j )
+        {
+            const S* EL_RESTRICT aCol = &ABuf[j*ALDim];
+                  T* EL_RESTRICT bCol = &BBuf[j*BLDim];
+            EL_SIMD
+            for( Int i=0; i<m; ++i )
+                bCol[i] = func(aCol[i]);
+        }
+    }
+}
+
+template<typename S,typename T,typename Functor>
+void EntrywiseMapParallel
+( const AbstractDistMatrix<S>& A,
+        AbstractDistMatrix<T>& B,
+        Functor func )
+{
+    EL_DEBUG_CSE
+    if( A.DistData().colDist == B.DistData().colDist &&
+        A.DistData().rowDist == B.DistData().rowDist &&
+        A.Wrap() == B.Wrap() )
+    {
+        B.AlignWith( A.DistData() );
+        B.Resize( A.Height(), A.Width() );
+        EntrywiseMapParallel( A.LockedMatrix(), B.Matrix(), func );
+    }
+    else
+    {
+        B.Resize( A.Height(), A.Width() );
+        #define GUARD(CDIST,RDIST,WRAP) \
+          B.DistData().colDist == CDIST && B.DistData().rowDist == RDIST && \
+          B.Wrap() == WRAP
+        #define PAYLOAD(CDIST,RDIST,WRAP) \
+          DistMatrix<S,CDIST,RDIST,WRAP> AProx(B.Grid()); \
+          AProx.AlignWith( B.DistData() ); \
+          Copy( A, AProx ); \
+          EntrywiseMapParallel( AProx.LockedMatrix(), B.Matrix(), func );
+        #include <El/macros/GuardAndPayload.h>
+        #undef GUARD
+        #undef PAYLOAD
+    }
+}
+
+// EntrywiseZip
+// ============
+// Fuse a map over the pairs of corresponding entries of A and B into C,
+// i.e., C(i,j) := func(A(i,j),B(i,j)), without forming any intermediates.
+
+template<typename R,typename S,typename T,typename Functor>
+void EntrywiseZip
+( const Matrix<R>& A,
+  const Matrix<S>& B,
+        Matrix<T>& C,
+        Functor func )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    if( B.Height() != m || B.Width() != n )
+        LogicError
+        ("A and B must be the same size, but A was ",m," x ",n," and B was ",
+         B.Height()," x ",B.Width());
+    C.Resize( m, n );
+    const R* EL_RESTRICT ABuf = A.LockedBuffer();
+    const S* EL_RESTRICT BBuf = B.LockedBuffer();
+          T* EL_RESTRICT CBuf = C.Buffer();
+    const Int ALDim = A.LDim();
+    const Int BLDim = B.LDim();
+    const Int CLDim = C.LDim();
+    if( ALDim == m && BLDim == m && CLDim == m )
+    {
+        const Int size = m*n;
+        EL_PARALLEL_FOR_SIMD
+        for( Int k=0; k<size; ++k )
+            CBuf[k] = func(ABuf[k],BBuf[k]);
+    }
+    else
+    {
+        EL_PARALLEL_FOR
+        for( Int j=0; j<n; ++j )
+        {
+            const R* EL_RESTRICT aCol = &ABuf[j*ALDim];
+            const S* EL_RESTRICT bCol = &BBuf[j*BLDim];
+                  T* EL_RESTRICT cCol = &CBuf[j*CLDim];
+            EL_SIMD
+            for( Int i=0; i<m; ++i )
+                cCol[i] = func(aCol[i],bCol[i]);
+        }
+    }
+}
+
+template<typename R,typename S,typename T,typename Functor>
+void EntrywiseZip
+( const AbstractDistMatrix<R>& A,
+  const AbstractDistMatrix<S>& B,
+        AbstractDistMatrix<T>& C,
+        Functor func )
+{
+    EL_DEBUG_CSE
+    EL_DEBUG_ONLY(AssertSameGrids( A, B, C ))
+    if( B.Height() != A.Height() || B.Width() != A.Width() )
+        LogicError
+        ("A and B must be the same size, but A was ",A.Height()," x ",
+         A.Width()," and B was ",B.Height()," x ",B.Width());
+    if( A.DistData().colDist == C.DistData().colDist &&
+        A.DistData().rowDist == C.DistData().rowDist &&
+        A.Wrap() == C.Wrap() && A.DistData() == B.DistData() )
+    {
+        C.AlignWith( A.DistData() );
+        C.Resize( A.Height(), A.Width() );
+        EntrywiseZip( A.LockedMatrix(), B.LockedMatrix(), C.Matrix(), func );
+    }
+    else
+    {
+        C.Resize( A.Height(), A.Width() );
+        #define GUARD(CDIST,RDIST,WRAP) \
+          C.DistData().colDist == CDIST && C.DistData().rowDist == RDIST && \
+          C.Wrap() == WRAP
+        #define PAYLOAD(CDIST,RDIST,WRAP) \
+          DistMatrix<R,CDIST,RDIST,WRAP> AProx(C.Grid()); \
+          DistMatrix<S,CDIST,RDIST,WRAP> BProx(C.Grid()); \
+          AProx.AlignWith( C.DistData() ); \
+          BProx.AlignWith( C.DistData() ); \
+          Copy( A, AProx ); \
+          Copy( B, BProx ); \
+          EntrywiseZip \
+          ( AProx.LockedMatrix(), BProx.LockedMatrix(), C.Matrix(), func );
+        #include <El/macros/GuardAndPayload.h>
+        #undef GUARD
+        #undef PAYLOAD
+    }
+}
+
 #ifdef EL_INSTANTIATE_BLAS_LEVEL1
 # define EL_EXTERN
 #else
@@ -227,6 +227,139 @@ void IndexDependentMap
     }
 }
 
+// Parallel variants for arbitrary functors
+// ========================================
+// These are instantiated for each functor type so that the functor can be
+// inlined into threaded, vectorized loops; the functor must be thread-safe,
+// so the variants are opt-in rather than overloads of IndexDependentMap.
+// The global row indices are computed once, rather than per entry.
+
+template<typename T,typename Functor>
+void IndexDependentMapParallel( Matrix<T>& A, Functor func )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    T* EL_RESTRICT ABuf = A.Buffer();
+    const Int ALDim = A.LDim();
+    if( n == 1 )
+    {
+        EL_PARALLEL_FOR_SIMD
+        for( Int i=0; i<m; ++i )
+            ABuf[i] = func(i,Int(0),ABuf[i]);
+    }
+    else
+    {
+        EL_PARALLEL_FOR
+        for( Int j=0; j<n; ++j )
+        {
+            T* EL_RESTRICT aCol = &ABuf[j*ALDim];
+            EL_SIMD
+            for( Int i=0; i<m; ++i )
+                aCol[i] = func(i,j,aCol[i]);
+        }
+    }
+}
+
+template<typename T,typename Functor>
+void IndexDependentMapParallel( AbstractDistMatrix<T>& A, Functor func )
+{
+    EL_DEBUG_CSE
+    const Int mLoc = A.LocalHeight();
+    const Int nLoc = A.LocalWidth();
+    T* EL_RESTRICT ALocBuf = A.Buffer();
+    const Int ALocLDim = A.LDim();
+
+    vector<Int> globalRows(mLoc);
+    for( Int iLoc=0; iLoc<mLoc; ++iLoc )
+        globalRows[iLoc] = A.GlobalRow(iLoc);
+    const Int* EL_RESTRICT rowBuf = globalRows.data();
+
+    if( nLoc == 1 )
+    {
+        const Int j = A.GlobalCol(0);
+        EL_PARALLEL_FOR_SIMD
+        for( Int iLoc=0; iLoc<mLoc; ++iLoc )
+            ALocBuf[iLoc] = func(rowBuf[iLoc],j,ALocBuf[iLoc]);
+    }
+    else
+    {
+        EL_PARALLEL_FOR
+        for( Int jLoc=0; jLoc<nLoc; ++jLoc )
+        {
+            const Int j = A.GlobalCol(jLoc);
+            T* EL_RESTRICT aCol = &ALocBuf[jLoc*ALocLDim];
+            EL_SIMD
+            for( Int iLoc=0; iLoc<mLoc; ++iLoc )
+                aCol[iLoc] = func(rowBuf[iLoc],j,aCol[iLoc]);
+        }
+    }
+}
+
+template<typename S,typename T,typename Functor>
+void IndexDependentMapParallel( const Matrix<S>& A, Matrix<T>& B, Functor func )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    B.Resize( m, n );
+    const S* EL_RESTRICT ABuf = A.LockedBuffer();
+          T* EL_RESTRICT BBuf = B.Buffer();
+    const Int ALDim = A.LDim();
+    const Int BLDim = B.LDim();
+    if( n == 1 )
+    {
+        EL_PARALLEL_FOR_SIMD
+        for( Int i=0; i<m; ++i )
+            BBuf[i] = func(i,Int(0),ABuf[i]);
+    }
+    else
+    {
+        EL_PARALLEL_FOR
+        for( Int j=0; j<n; ++j )
+        {
+            const S* EL_RESTRICT aCol = &ABuf[j*ALDim];
+                  T* EL_RESTRICT bCol = &BBuf[j*BLDim];
+            EL_SIMD
+            for( Int i=0; i<m; ++i )
+                bCol[i] = func(i,j,aCol[i]);
+        }
+    }
+}
+
+template<typename S,typename T,Dist U,Dist V,DistWrap wrap,typename Functor>
+void IndexDependentMapParallel
+( const DistMatrix<S,U,V,wrap>& A,
+        DistMatrix<T,U,V,wrap>& B,
+        Functor func )
+{
+    EL_DEBUG_CSE
+    const Int mLoc = A.LocalHeight();
+    const Int nLoc = A.LocalWidth();
+    B.AlignWith( A.DistData() );
+    B.Resize( A.Height(), A.Width() );
+    const S* EL_RESTRICT ALocBuf = A.LockedBuffer();
+          T* EL_RESTRICT BLocBuf = B.Buffer();
+    const Int ALocLDim = A.LDim();
+    const Int BLocLDim = B.LDim();
+
+    vector<Int> globalRows(mLoc);
+    for( Int iLoc=0; iLoc<mLoc; ++iLoc )
+        globalRows[iLoc] = A.GlobalRow(iLoc);
+    const Int* EL_RESTRICT rowBuf = globalRows.data();
+
+    EL_PARALLEL_FOR
+    for( Int jLoc=0; jLoc<nLoc; ++jLoc )
+    {
+        const Int j = A.GlobalCol(jLoc);
+        const S* EL_RESTRICT aCol = &ALocBuf[jLoc*ALocLDim];
+              T* EL_RESTRICT bCol = &BLocBuf[jLoc*BLocLDim];
+        EL_SIMD
+        for( Int iLoc=0; iLoc<mLoc; ++iLoc )
+            bCol[iLoc] = func(rowBuf[iLoc],j,aCol[iLoc]);
+    }
+}
+
 #ifdef EL_INSTANTIATE_BLAS_LEVEL1
 # define EL_EXTERN
 #else
@@ -165,6 +165,19 @@ void Broadcast( Matrix<T>& A, mpi::Comm comm, int rank=0 );
 template<typename T>
 void Broadcast( AbstractDistMatrix<T>& A, mpi::Comm comm, int rank=0 );
 
+// BulkUpdate
+// ==========
+// Collectively add each process's dense block, whose rows have the global
+// indices 'rows' and whose columns are the global columns
+// [colOffset,colOffset+block.Width()), into A. This is a bulk alternative to
+// QueueUpdate/ProcessQueues for ingesting whole rows (or blocks of rows).
+template<typename T>
+void BulkUpdate
+(       AbstractDistMatrix<T>& A,
+  const vector<Int>& rows,
+  const Matrix<T>& block,
+        Int colOffset=0 );
+
 // Send
 // ====
 template<typename T>
@@ -504,6 +517,31 @@ template<typename S,typename T,
          typename=EnableIf<And< CanCast<S,T>, Not<IsSame<S,T>> >>>
 void Copy( const AbstractDistMatrix<S>& A, AbstractDistMatrix<T>& B );
 
+// Nonblocking redistribution
+// --------------------------
+// ICopy starts the redistribution of A into B, which must not be accessed (and
+// A must not be modified) until request.Wait() returns or request.Test()
+// returns true. Only the (aligned) all-gathers which collect the column or
+// row distribution, e.g., [MC,MR] -> [MC,* ] or [VC,* ] -> [* ,* ], are
+// currently overlapped; any other redistribution completes within ICopy.
+template<typename T> class CopyRequest;
+
+template<typename T>
+void ICopy
+( const ElementalMatrix<T>& A, ElementalMatrix<T>& B, CopyRequest<T>& request );
+
+// An approximate bound on the number of bytes each process sends in a single
+// round of a general-purpose redistribution (256 MB by default)
+void SetRedistMemoryLimit( Int bytes );
+Int RedistMemoryLimit();
+
+// Whether all-gathers onto [STAR,STAR] (e.g., from [MC,MR] or [VC,STAR]) of
+// processes sharing a node go through an MPI shared-memory window, so that
+// only a single copy of the gathered data crosses the network per node
+// (disabled by default)
+void SetSharedMemoryRedist( bool enable );
+bool SharedMemoryRedist();
+
 template<typename T>
 void CopyFromRoot
 ( const Matrix<T>& A, DistMatrix<T,CIRC,CIRC>& B,
@@ -824,6 +862,14 @@ void EntrywiseFill( AbstractDistMatrix<T>& A, function<T(void)> func );
 template<typename T>
 void EntrywiseFill( DistMultiVec<T>& A, function<T(void)> func );
 
+// Inlinable (and threaded) variants for arbitrary thread-safe functors
+template<typename T,typename Functor>
+void EntrywiseFillParallel( Matrix<T>& A, Functor func );
+template<typename T,typename Functor>
+void EntrywiseFillParallel( AbstractDistMatrix<T>& A, Functor func );
+template<typename T,typename Functor>
+void EntrywiseFillParallel( DistMultiVec<T>& A, Functor func );
+
 // EntrywiseMap
 // ============
 template<typename T>
@@ -856,6 +902,33 @@ void EntrywiseMap
 ( const DistMultiVec<S>& A, DistMultiVec<T>& B,
   function<T(const S&)> func );
 
+// Inlinable (and threaded) variants for arbitrary thread-safe functors
+template<typename T,typename Functor>
+void EntrywiseMapParallel( Matrix<T>& A, Functor func );
+template<typename T,typename Functor>
+void EntrywiseMapParallel( AbstractDistMatrix<T>& A, Functor func );
+template<typename T,typename Functor>
+void EntrywiseMapParallel( DistMultiVec<T>& A, Functor func );
+
+template<typename S,typename T,typename Functor>
+void EntrywiseMapParallel( const Matrix<S>& A, Matrix<T>& B, Functor func );
+template<typename S,typename T,typename Functor>
+void EntrywiseMapParallel
+( const AbstractDistMatrix<S>& A, AbstractDistMatrix<T>& B, Functor func );
+
+// EntrywiseZip
+// ============
+// C(i,j) := func(A(i,j),B(i,j))
+template<typename R,typename S,typename T,typename Functor>
+void EntrywiseZip
+( const Matrix<R>& A, const Matrix<S>& B, Matrix<T>& C, Functor func );
+template<typename R,typename S,typename T,typename Functor>
+void EntrywiseZip
+( const AbstractDistMatrix<R>& A,
+  const AbstractDistMatrix<S>& B,
+        AbstractDistMatrix<T>& C,
+        Functor func );
+
 // Fill
 // ====
 template<typename T>
@@ -1221,6 +1294,20 @@ void IndexDependentMap
         DistMatrix<T,U,V,BLOCK>& B,
         function<T(Int,Int,const S&)> func );
 
+// Inlinable (and threaded) variants for arbitrary thread-safe functors
+template<typename T,typename Functor>
+void IndexDependentMapParallel( Matrix<T>& A, Functor func );
+template<typename T,typename Functor>
+void IndexDependentMapParallel( AbstractDistMatrix<T>& A, Functor func );
+template<typename S,typename T,typename Functor>
+void IndexDependentMapParallel
+( const Matrix<S>& A, Matrix<T>& B, Functor func );
+template<typename S,typename T,Dist U,Dist V,DistWrap wrap,typename Functor>
+void IndexDependentMapParallel
+( const DistMatrix<S,U,V,wrap>& A,
+        DistMatrix<T,U,V,wrap>& B,
+        Functor func );
+
 // Kronecker product
 // =================
 template<typename T>
@@ -14,6 +14,7 @@
 #include <El/blas_like/level1/AxpyContract.hpp>
 #include <El/blas_like/level1/AxpyTrapezoid.hpp>
 #include <El/blas_like/level1/Broadcast.hpp>
+#include <El/blas_like/level1/BulkUpdate.hpp>
 #include <El/blas_like/level1/Concatenate.hpp>
 #include <El/blas_like/level1/Conjugate.hpp>
 #include <El/blas_like/level1/ConjugateDiagonal.hpp>
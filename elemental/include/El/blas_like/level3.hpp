@@ -31,6 +31,37 @@ enum GemmAlgorithm {
 }
 using namespace GemmAlgorithmNS;
 
+// Gemm25D splits the processes into layers which each compute the product
+// of a slice of the inner dimension before the results are summed
+// (see gemm::SUMMA25D). The number of layers may be forced to a fixed
+// divisor of the number of processes; the default of zero lets
+// gemm::Layers25D choose it from the problem size and the memory limit,
+// which bounds the bytes per process spent on the extra copies of C. When a
+// single layer is chosen, Gemm25D is equivalent to Gemm.
+void SetGemm25DLayers( Int numLayers );
+Int Gemm25DLayers();
+void SetGemm25DMemoryLimit( double bytes );
+double Gemm25DMemoryLimit();
+
+template<typename T>
+void Gemm25D
+( Orientation orientA, Orientation orientB,
+  T alpha, const AbstractDistMatrix<T>& A, const AbstractDistMatrix<T>& B,
+  T beta,        AbstractDistMatrix<T>& C );
+
+namespace gemm {
+
+template<typename T>
+Int Layers25D( Int m, Int n, Int k, const Grid& g );
+
+template<typename T>
+void SUMMA25D
+( Orientation orientA, Orientation orientB,
+  T alpha, const AbstractDistMatrix<T>& A, const AbstractDistMatrix<T>& B,
+  T beta,        AbstractDistMatrix<T>& C, Int numLayers );
+
+} // namespace gemm
+
 template<typename T>
 void Gemm
 ( Orientation orientA, Orientation orientB,
@@ -651,4 +682,6 @@ void NormalFromEVD
 
 } // namespace El
 
+#include <El/blas_like/level3/Gemm25D.hpp>
+
 #endif // ifndef EL_BLAS3_HPP
@@ -0,0 +1,247 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_BLAS3_GEMM25D_HPP
+#define EL_BLAS3_GEMM25D_HPP
+
+namespace El {
+
+namespace gemm {
+
+inline Int& Layers25DRef()
+{
+    static Int numLayers = 0;
+    return numLayers;
+}
+
+inline double& MemoryLimit25DRef()
+{
+    static double memoryLimit = 1024.*1024.*1024.;
+    return memoryLimit;
+}
+
+} // namespace gemm
+
+inline void SetGemm25DLayers( Int numLayers )
+{
+    if( numLayers < 0 )
+        LogicError("The number of layers must be non-negative");
+    gemm::Layers25DRef() = numLayers;
+}
+inline Int Gemm25DLayers() { return gemm::Layers25DRef(); }
+
+inline void SetGemm25DMemoryLimit( double bytes )
+{ gemm::MemoryLimit25DRef() = bytes; }
+inline double Gemm25DMemoryLimit() { return gemm::MemoryLimit25DRef(); }
+
+namespace gemm {
+
+// Choose the number of layers for Gemm25D
+// =======================================
+// A forced number of layers (see SetGemm25DLayers) is returned as is.
+// Otherwise, every divisor c <= p^(1/3) of the number of processes p whose
+// c-1 extra copies of C fit within Gemm25DMemoryLimit() is considered, and
+// the one minimizing the per-process communication volume
+//
+//   (m k + k n) / sqrt(c p)   (SUMMA within each layer)
+//   + (m k + k n) / p         (distributing the inner-dimension slices)
+//   + (c-1) m n / p           (summing the partial products)
+//
+// is chosen. A return value of one means that a 2D algorithm is preferred.
+template<typename T>
+Int Layers25D( Int m, Int n, Int k, const Grid& g )
+{
+    EL_DEBUG_CSE
+    const int p = g.Size();
+    const Int forcedLayers = Gemm25DLayers();
+    if( forcedLayers > 0 )
+        return forcedLayers;
+
+    const double inputVol = double(m)*k + double(k)*n;
+    const double outputVol = double(m)*n;
+    const double memoryLimit = Gemm25DMemoryLimit();
+    Int bestLayers = 1;
+    double bestCost = inputVol/Sqrt(double(p));
+    for( Int c=2; c*c*c<=p; ++c )
+    {
+        if( p % c != 0 )
+            continue;
+        if( (c-1)*outputVol*sizeof(T)/p > memoryLimit )
+            break;
+        const double cost =
+          inputVol/Sqrt(double(c)*p) + inputVol/p + (c-1)*outputVol/p;
+        if( cost < bestCost )
+        {
+            bestLayers = c;
+            bestCost = cost;
+        }
+    }
+    return bestLayers;
+}
+
+// A partition of a grid into layers, along with the communicator connecting
+// the processes which own the same portion of each layer's grid
+struct LayerPartition25D
+{
+    GridPartition layers;
+    // mpi::COMM_NULL on the processes outside of the grid
+    mpi::Comm crossComm=mpi::COMM_NULL;
+
+    LayerPartition25D( const Grid& g, int numLayers )
+    : layers(g,numLayers)
+    {
+        if( g.InGrid() )
+        {
+            const int layerSize = g.Size() / numLayers;
+            mpi::Split
+            ( g.Comm(), g.OwningRank() % layerSize, layers.MyPart(),
+              crossComm );
+        }
+    }
+
+    ~LayerPartition25D()
+    {
+        if( crossComm != mpi::COMM_NULL )
+            mpi::Free( crossComm );
+    }
+};
+
+// The layers of the most recently used grid are kept between calls since
+// forming the layer grids and the cross-layer communicator requires several
+// collectives. They are deliberately never freed, as a static object would
+// only be destroyed after MPI has been finalized.
+inline const LayerPartition25D& Layers25DCache( const Grid& g, int numLayers )
+{
+    EL_DEBUG_CSE
+    static LayerPartition25D* partition = nullptr;
+    if( partition == nullptr ||
+        partition->layers.NumParts() != numLayers ||
+        !partition->layers.Partitions(g) )
+    {
+        delete partition;
+        partition = nullptr;
+        partition = new LayerPartition25D( g, numLayers );
+    }
+    return *partition;
+}
+
+// Communication-avoiding (2.5D) SUMMA
+// ===================================
+// The p processes of C's grid are split into c=numLayers layers of p/c
+// consecutive processes, each of which forms its own grid. Layer l receives
+// the l'th of c contiguous slices of the inner dimension of A and B, forms
+// its partial product with a stationary-C SUMMA, and the c partial products
+// are then summed across layers and added into C. Relative to a SUMMA over
+// all p processes, each layer's SUMMA communicates a factor of sqrt(c) fewer
+// entries per process, at the price of c copies of C.
+template<typename T>
+void SUMMA25D
+( Orientation orientA,
+  Orientation orientB,
+  T alpha,
+  const AbstractDistMatrix<T>& APre,
+  const AbstractDistMatrix<T>& BPre,
+  T beta,
+        AbstractDistMatrix<T>& C,
+  Int numLayers )
+{
+    EL_DEBUG_CSE
+    EL_DEBUG_ONLY(AssertSameGrids( APre.Grid(), BPre.Grid(), C.Grid() ))
+    const Grid& g = C.Grid();
+    const int p = g.Size();
+    if( numLayers < 1 || p % numLayers != 0 )
+        LogicError
+        ("The number of layers, ",numLayers,", must divide the number of "
+         "processes, ",p);
+    const Int m = C.Height();
+    const Int n = C.Width();
+    const Int k = ( orientA == NORMAL ? APre.Width() : APre.Height() );
+
+    DistMatrixReadProxy<T,T,MC,MR> AProx( APre ), BProx( BPre );
+    auto& A = AProx.GetLocked();
+    auto& B = BProx.GetLocked();
+
+    // Split the processes into layers of consecutive owning ranks
+    const auto& partition = Layers25DCache( g, numLayers );
+    const GridPartition& layers = partition.layers;
+    const bool inGrid = g.InGrid();
+    const int myLayer = layers.MyPart();
+
+    // Send the l'th slice of the inner dimension to the l'th layer
+    // ============================================================
+    vector<unique_ptr<DistMatrix<T>>> ALayers(numLayers), BLayers(numLayers),
+      CLayers(numLayers);
+    for( Int l=0; l<numLayers; ++l )
+    {
+        const Range<Int> ind( (l*k)/numLayers, ((l+1)*k)/numLayers );
+        ALayers[l].reset( new DistMatrix<T>(layers.PartGrid(l)) );
+        BLayers[l].reset( new DistMatrix<T>(layers.PartGrid(l)) );
+        CLayers[l].reset( new DistMatrix<T>(layers.PartGrid(l)) );
+        auto ASlice = ( orientA == NORMAL ? A(ALL,ind) : A(ind,ALL) );
+        auto BSlice = ( orientB == NORMAL ? B(ind,ALL) : B(ALL,ind) );
+        copy::TranslateBetweenGrids( ASlice, *ALayers[l] );
+        copy::TranslateBetweenGrids( BSlice, *BLayers[l] );
+        Zeros( *CLayers[l], m, n );
+    }
+
+    // Form the partial products and sum them onto the first layer
+    // ===========================================================
+    if( inGrid )
+    {
+        auto& CLayer = *CLayers[myLayer];
+        Gemm
+        ( orientA, orientB,
+          alpha, *ALayers[myLayer], *BLayers[myLayer],
+          T(0), CLayer, GEMM_SUMMA_C );
+        ALayers[myLayer]->Empty();
+        BLayers[myLayer]->Empty();
+
+        // Corresponding processes of each layer own the same local portion
+        // of their layer's product
+        mpi::Reduce
+        ( CLayer.Buffer(), CLayer.LDim()*CLayer.LocalWidth(), 0,
+          partition.crossComm );
+    }
+
+    // Return the sum to C's grid
+    // ==========================
+    DistMatrix<T> CSum(g);
+    copy::TranslateBetweenGrids( *CLayers[0], CSum );
+    ALayers.clear();
+    BLayers.clear();
+    CLayers.clear();
+
+    Scale( beta, C );
+    Axpy( T(1), CSum, C );
+}
+
+} // namespace gemm
+
+template<typename T>
+void Gemm25D
+( Orientation orientA,
+  Orientation orientB,
+  T alpha,
+  const AbstractDistMatrix<T>& A,
+  const AbstractDistMatrix<T>& B,
+  T beta,
+        AbstractDistMatrix<T>& C )
+{
+    EL_DEBUG_CSE
+    const Int k = ( orientA == NORMAL ? A.Width() : A.Height() );
+    const Int numLayers =
+      gemm::Layers25D<T>( C.Height(), C.Width(), k, C.Grid() );
+    if( numLayers > 1 )
+        gemm::SUMMA25D( orientA, orientB, alpha, A, B, beta, C, numLayers );
+    else
+        Gemm( orientA, orientB, alpha, A, B, beta, C );
+}
+
+} // namespace El
+
+#endif // ifndef EL_BLAS3_GEMM25D_HPP
@@ -14,21 +14,29 @@
 #include <mpi.h>
 
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <random>
 #include <type_traits> // std::enable_if
+#include <unordered_map>
 #include <vector>
 
 #define EL_UNUSED(expr) (void)(expr)
@@ -253,6 +261,7 @@ template<typename T> struct IsStdField<Complex<T>>
 #include <El/core/imports/choice.hpp>
 #include <El/core/imports/mpi_choice.hpp>
 #include <El/core/environment/decl.hpp>
+#include <El/core/imports/mpi_profile.hpp>
 
 #include <El/core/Timer.hpp>
 #include <El/core/indexing/decl.hpp>
@@ -294,6 +303,7 @@ class DistMatrix;
 
 #include <El/core/Matrix/impl.hpp>
 #include <El/core/Grid.hpp>
+#include <El/core/GridPartition.hpp>
 #include <El/core/DistMatrix.hpp>
 #include <El/core/Proxy.hpp>
 
@@ -319,5 +329,6 @@ class DistMatrix;
 
 #include <El/core/Permutation.hpp>
 #include <El/core/DistPermutation.hpp>
+#include <El/core/DiskMatrix.hpp>
 
 #endif // ifndef EL_CORE_HPP
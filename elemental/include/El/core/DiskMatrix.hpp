@@ -0,0 +1,206 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_CORE_DISKMATRIX_HPP
+#define EL_CORE_DISKMATRIX_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace El {
+
+// A matrix which is stored in node-local files rather than in memory so that
+// it may exceed the aggregate memory of the processes which own it.
+//
+// The matrix is partitioned into square tiles of tileSize x tileSize entries
+// (with the last tile row and column possibly being smaller), and tile (I,J)
+// is stored as the local data of an [MC,MR] matrix over the given grid which
+// is aligned with the top-left entry of the tile. Each process stores its
+// portions of the tiles in fixed slots of a single file within 'directory'
+// so that tiles may be read and written in any order (and so that the slots
+// of tiles which are never written, e.g., the strictly upper triangle of a
+// Cholesky factor, need not occupy space on most file systems).
+//
+// Reading and writing the local portions of tiles does not involve any
+// communication and may be performed concurrently from different threads.
+template<typename Field>
+class DiskMatrix
+{
+public:
+    DiskMatrix
+    ( const El::Grid& grid,
+      Int height,
+      Int width,
+      Int tileSize,
+      const string& directory="." );
+    ~DiskMatrix();
+
+    DiskMatrix( const DiskMatrix<Field>& A ) = delete;
+    const DiskMatrix<Field>& operator=( const DiskMatrix<Field>& A ) = delete;
+
+    const El::Grid& Grid() const EL_NO_EXCEPT { return *grid_; }
+    Int Height() const EL_NO_EXCEPT { return height_; }
+    Int Width() const EL_NO_EXCEPT { return width_; }
+    Int TileSize() const EL_NO_EXCEPT { return tileSize_; }
+    const string& Filename() const EL_NO_EXCEPT { return filename_; }
+
+    Int NumTileRows() const EL_NO_EXCEPT
+    { return (height_+tileSize_-1) / tileSize_; }
+    Int NumTileCols() const EL_NO_EXCEPT
+    { return (width_+tileSize_-1) / tileSize_; }
+    Int TileHeight( Int I ) const EL_NO_EXCEPT
+    { return Min( tileSize_, height_-I*tileSize_ ); }
+    Int TileWidth( Int J ) const EL_NO_EXCEPT
+    { return Min( tileSize_, width_-J*tileSize_ ); }
+
+    Int LocalTileHeight( Int I ) const EL_NO_EXCEPT;
+    Int LocalTileWidth( Int J ) const EL_NO_EXCEPT;
+
+    // Read/write the local portions of tiles (I0,J), (I0+1,J), ..., (I1-1,J)
+    void ReadLocalTiles
+    ( Int J, Int I0, Int I1, vector<Matrix<Field>>& tiles ) const;
+    void WriteLocalTiles
+    ( Int J, Int I0, Int I1, const vector<Matrix<Field>>& tiles ) const;
+
+private:
+    const El::Grid* grid_;
+    Int height_, width_, tileSize_;
+    string filename_;
+    std::streamoff slotSize_;
+
+    std::streamoff Offset( Int I, Int J ) const EL_NO_EXCEPT
+    { return (I+J*NumTileRows())*slotSize_; }
+};
+
+template<typename Field>
+DiskMatrix<Field>::DiskMatrix
+( const El::Grid& grid,
+  Int height,
+  Int width,
+  Int tileSize,
+  const string& directory )
+: grid_(&grid), height_(height), width_(width), tileSize_(tileSize)
+{
+    EL_DEBUG_CSE
+    if( height < 0 || width < 0 )
+        LogicError("Height and width must be non-negative");
+    if( tileSize <= 0 )
+        LogicError("Tile size must be positive");
+
+    // Let mkstemp atomically create a file with a unique name so that the
+    // matrices of different types, threads, and jobs sharing the directory
+    // can never clobber (or remove) each other's files
+    std::ostringstream os;
+    os << directory << "/El-DiskMatrix-" << mpi::Rank(mpi::COMM_WORLD)
+       << "-XXXXXX";
+    const string pattern = os.str();
+    vector<char> filename( pattern.c_str(), pattern.c_str()+pattern.size()+1 );
+    const int fd = ::mkstemp( filename.data() );
+    if( fd == -1 )
+        RuntimeError("Could not create a file within ",directory);
+    ::close( fd );
+    filename_ = filename.data();
+
+    if( grid.InGrid() )
+        slotSize_ = std::streamoff(MaxLength(tileSize,grid.MCSize()))*
+                    MaxLength(tileSize,grid.MRSize())*sizeof(Field);
+    else
+        slotSize_ = 0;
+}
+
+template<typename Field>
+DiskMatrix<Field>::~DiskMatrix()
+{ std::remove( filename_.c_str() ); }
+
+template<typename Field>
+Int DiskMatrix<Field>::LocalTileHeight( Int I ) const EL_NO_EXCEPT
+{
+    if( !grid_->InGrid() )
+        return 0;
+    return Length( TileHeight(I), grid_->MCRank(), grid_->MCSize() );
+}
+
+template<typename Field>
+Int DiskMatrix<Field>::LocalTileWidth( Int J ) const EL_NO_EXCEPT
+{
+    if( !grid_->InGrid() )
+        return 0;
+    return Length( TileWidth(J), grid_->MRRank(), grid_->MRSize() );
+}
+
+template<typename Field>
+void DiskMatrix<Field>::ReadLocalTiles
+( Int J, Int I0, Int I1, vector<Matrix<Field>>& tiles ) const
+{
+    EL_DEBUG_CSE
+    EL_DEBUG_ONLY(
+      if( J < 0 || J >= NumTileCols() || I0 < 0 || I1 > NumTileRows() )
+          LogicError("Tile range is out of bounds");
+    )
+    std::ifstream file( filename_.c_str(), std::ios::binary );
+    if( !file.is_open() )
+        RuntimeError("Could not open ",filename_);
+
+    const Int localWidth = LocalTileWidth( J );
+    tiles.resize( Max(I1-I0,Int(0)) );
+    for( Int I=I0; I<I1; ++I )
+    {
+        auto& tile = tiles[I-I0];
+        const Int localHeight = LocalTileHeight( I );
+        tile.Resize( localHeight, localWidth, Max(localHeight,Int(1)) );
+        if( localHeight == 0 || localWidth == 0 )
+            continue;
+        file.seekg( Offset(I,J) );
+        file.read
+        ( reinterpret_cast<char*>(tile.Buffer()),
+          localHeight*localWidth*sizeof(Field) );
+        if( !file )
+            RuntimeError("Could not read tile (",I,",",J,") of ",filename_);
+    }
+}
+
+template<typename Field>
+void DiskMatrix<Field>::WriteLocalTiles
+( Int J, Int I0, Int I1, const vector<Matrix<Field>>& tiles ) const
+{
+    EL_DEBUG_CSE
+    EL_DEBUG_ONLY(
+      if( J < 0 || J >= NumTileCols() || I0 < 0 || I1 > NumTileRows() )
+          LogicError("Tile range is out of bounds");
+      if( Int(tiles.size()) != I1-I0 )
+          LogicError("Wrong number of tiles");
+    )
+    std::fstream file
+    ( filename_.c_str(), std::ios::binary|std::ios::in|std::ios::out );
+    if( !file.is_open() )
+        RuntimeError("Could not open ",filename_);
+
+    const Int localWidth = LocalTileWidth( J );
+    for( Int I=I0; I<I1; ++I )
+    {
+        const auto& tile = tiles[I-I0];
+        const Int localHeight = LocalTileHeight( I );
+        if( tile.Height() != localHeight || tile.Width() != localWidth )
+            LogicError("Tile (",I,",",J,") has the wrong local dimensions");
+        if( localHeight == 0 || localWidth == 0 )
+            continue;
+        file.seekp( Offset(I,J) );
+        // Store the tile contiguously, regardless of its leading dimension
+        for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+            file.write
+            ( reinterpret_cast<const char*>(tile.LockedBuffer(0,jLoc)),
+              localHeight*sizeof(Field) );
+        if( !file )
+            RuntimeError("Could not write tile (",I,",",J,") of ",filename_);
+    }
+}
+
+} // namespace El
+
+#endif // ifndef EL_CORE_DISKMATRIX_HPP
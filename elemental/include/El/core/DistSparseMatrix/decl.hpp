@@ -88,6 +88,41 @@ public:
     void ProcessQueues();
     void ProcessLocalQueues();
 
+    // Bulk assembly from coordinate (COO) and compressed-row (CSR) buffers
+    // ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+    // QueueUpdates reserves space for, and then queues, a contiguous batch of
+    // triplets without processing the queues.
+    //
+    // The Assemble routines are collective: each process passes the entries
+    // that it happens to hold (which need not be the rows that it owns), and
+    // the remote entries are exchanged in rounds of at most 'batchSize' local
+    // entries so that the remote queues never hold more than a single batch.
+    // The local entries are only sorted and combined once, after the last
+    // round. The resulting memory usage is proportional to the number of
+    // nonzeros rather than to the dimensions of the matrix.
+    void QueueUpdates
+    ( Int numEntries,
+      const Int* rows,
+      const Int* cols,
+      const Ring* values,
+      bool passive=false );
+    void AssembleCOO
+    ( Int numEntries,
+      const Int* rows,
+      const Int* cols,
+      const Ring* values,
+      Int batchSize=(1<<20) );
+    // The CSR buffers describe the global rows [firstRow,firstRow+numRows),
+    // with the nonzeros of row firstRow+i stored in the half-open range
+    // [rowOffsets[i],rowOffsets[i+1]) of 'cols' and 'values'.
+    void AssembleCSR
+    ( Int firstRow,
+      Int numRows,
+      const Int* rowOffsets,
+      const Int* cols,
+      const Ring* values,
+      Int batchSize=(1<<20) );
+
     // Operator overloading
     // ====================
 
@@ -186,6 +221,10 @@ private:
 
     void InitializeLocalData();
 
+    // Send the queued remote updates to their owners and queue them locally
+    // (without sorting or combining the local entries)
+    void ExchangeRemoteUpdates( bool reserve=true );
+
     static bool CompareEntries( const Entry<Ring>& a, const Entry<Ring>& b );
 
     template<typename U> friend class SparseMatrix;
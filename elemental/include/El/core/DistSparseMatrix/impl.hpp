@@ -252,42 +252,12 @@ void DistSparseMatrix<Ring>::ProcessQueues()
           LogicError("Inconsistent sparse matrix buffer sizes");
     )
 
-    // Send the remote updates
-    // =======================
     mpi::Comm comm = distGraph_.grid_->Comm();
     const int commSize = distGraph_.grid_->Size();
-    {
-        // Compute the send counts
-        // -----------------------
-        vector<int> sendCounts(commSize,0);
-        for( auto s : distGraph_.remoteSources_ )
-            ++sendCounts[RowOwner(s)];
 
-        // Pack the send data
-        // ------------------
-        vector<int> sendOffs;
-        const int totalSend = Scan( sendCounts, sendOffs );
-        auto offs = sendOffs;
-        vector<Entry<Ring>> sendBuf(totalSend);
-        for( Int i=0; i<totalSend; ++i )
-        {
-            const int owner = RowOwner(distGraph_.remoteSources_[i]);
-            sendBuf[offs[owner]++] =
-                Entry<Ring>
-                { distGraph_.remoteSources_[i],
-                  distGraph_.remoteTargets_[i], remoteVals_[i] };
-        }
-        SwapClear( distGraph_.remoteSources_ );
-        SwapClear( distGraph_.remoteTargets_ );
-        SwapClear( remoteVals_ );
-        // Exchange and unpack
-        // -------------------
-        auto recvBuf = mpi::AllToAll( sendBuf, sendCounts, sendOffs, comm );
-        if( !FrozenSparsity() )
-            Reserve( NumLocalEntries()+recvBuf.size() );
-        for( auto& entry : recvBuf )
-            QueueUpdate( entry );
-    }
+    // Send the remote updates
+    // =======================
+    ExchangeRemoteUpdates();
 
     // Send the remote entry removals
     // ==============================
@@ -326,6 +296,46 @@ void DistSparseMatrix<Ring>::ProcessQueues()
     ProcessLocalQueues();
 }
 
+template<typename Ring>
+void DistSparseMatrix<Ring>::ExchangeRemoteUpdates( bool reserve )
+{
+    EL_DEBUG_CSE
+    mpi::Comm comm = distGraph_.grid_->Comm();
+    const int commSize = distGraph_.grid_->Size();
+
+    // Compute the send counts
+    // -----------------------
+    vector<int> sendCounts(commSize,0);
+    for( auto s : distGraph_.remoteSources_ )
+        ++sendCounts[RowOwner(s)];
+
+    // Pack the send data
+    // ------------------
+    vector<int> sendOffs;
+    const int totalSend = Scan( sendCounts, sendOffs );
+    auto offs = sendOffs;
+    vector<Entry<Ring>> sendBuf(totalSend);
+    for( Int i=0; i<totalSend; ++i )
+    {
+        const int owner = RowOwner(distGraph_.remoteSources_[i]);
+        sendBuf[offs[owner]++] =
+            Entry<Ring>
+            { distGraph_.remoteSources_[i],
+              distGraph_.remoteTargets_[i], remoteVals_[i] };
+    }
+    SwapClear( distGraph_.remoteSources_ );
+    SwapClear( distGraph_.remoteTargets_ );
+    SwapClear( remoteVals_ );
+
+    // Exchange and unpack
+    // -------------------
+    auto recvBuf = mpi::AllToAll( sendBuf, sendCounts, sendOffs, comm );
+    if( reserve && !FrozenSparsity() )
+        Reserve( NumLocalEntries()+recvBuf.size() );
+    for( auto& entry : recvBuf )
+        QueueUpdate( entry );
+}
+
 template<typename Ring>
 void DistSparseMatrix<Ring>::ProcessLocalQueues()
 {
@@ -393,6 +403,139 @@ void DistSparseMatrix<Ring>::ProcessLocalQueues()
     distGraph_.locallyConsistent_ = true;
 }
 
+template<typename Ring>
+void DistSparseMatrix<Ring>::QueueUpdates
+( Int numEntries,
+  const Int* rows,
+  const Int* cols,
+  const Ring* values,
+  bool passive )
+{
+    EL_DEBUG_CSE
+    if( !FrozenSparsity() )
+    {
+        const Int firstLocalRow = FirstLocalRow();
+        const Int localHeight = LocalHeight();
+        Int numLocal = 0;
+        for( Int e=0; e<numEntries; ++e )
+        {
+            const Int row = ( rows[e] == END ? Height()-1 : rows[e] );
+            if( row >= firstLocalRow && row < firstLocalRow+localHeight )
+                ++numLocal;
+        }
+        Reserve( numLocal, passive ? 0 : numEntries-numLocal );
+    }
+    for( Int e=0; e<numEntries; ++e )
+        QueueUpdate( rows[e], cols[e], values[e], passive );
+}
+
+template<typename Ring>
+void DistSparseMatrix<Ring>::AssembleCOO
+( Int numEntries,
+  const Int* rows,
+  const Int* cols,
+  const Ring* values,
+  Int batchSize )
+{
+    EL_DEBUG_CSE
+    if( batchSize <= 0 )
+        LogicError("Batch size must be positive");
+
+    // Every process must take part in the same number of exchanges
+    const Int numLocalBatches = (numEntries+batchSize-1) / batchSize;
+    const Int numBatches =
+      mpi::AllReduce( numLocalBatches, mpi::MAX, Grid().Comm() );
+    if( !FrozenSparsity() )
+    {
+        // Reserve the local storage for every entry that this process will
+        // own, including those received from the other processes
+        const int commSize = Grid().Size();
+        vector<Int> sendCounts(commSize,0), recvCounts(commSize);
+        for( Int e=0; e<numEntries; ++e )
+        {
+            const Int row = ( rows[e] == END ? Height()-1 : rows[e] );
+            ++sendCounts[RowOwner(row)];
+        }
+        mpi::AllToAll
+        ( sendCounts.data(), 1, recvCounts.data(), 1, Grid().Comm() );
+        Int numLocal = 0;
+        for( const Int count : recvCounts )
+            numLocal += count;
+        const Int numRemote = numEntries - sendCounts[mpi::Rank(Grid().Comm())];
+        Reserve( numLocal, Min(batchSize,numRemote) );
+    }
+    for( Int batch=0; batch<numBatches; ++batch )
+    {
+        const Int off = Min(batch*batchSize,numEntries);
+        const Int thisBatchSize = Min(batchSize,numEntries-off);
+        for( Int e=off; e<off+thisBatchSize; ++e )
+            QueueUpdate( rows[e], cols[e], values[e] );
+        ExchangeRemoteUpdates( false );
+    }
+    // Sort and combine the local entries (and process any removals) once
+    ProcessQueues();
+}
+
+template<typename Ring>
+void DistSparseMatrix<Ring>::AssembleCSR
+( Int firstRow,
+  Int numRows,
+  const Int* rowOffsets,
+  const Int* cols,
+  const Ring* values,
+  Int batchSize )
+{
+    EL_DEBUG_CSE
+    if( batchSize <= 0 )
+        LogicError("Batch size must be positive");
+    const Int numEntries = ( numRows > 0 ? rowOffsets[numRows] : 0 );
+    const Int baseOff = ( numRows > 0 ? rowOffsets[0] : 0 );
+
+    const Int numLocalBatches = (numEntries-baseOff+batchSize-1) / batchSize;
+    const Int numBatches =
+      mpi::AllReduce( numLocalBatches, mpi::MAX, Grid().Comm() );
+    if( !FrozenSparsity() )
+    {
+        // Reserve the local storage for every entry that this process will
+        // own, including those received from the other processes
+        const int commSize = Grid().Size();
+        vector<Int> sendCounts(commSize,0), recvCounts(commSize);
+        for( Int i=0; i<numRows; ++i )
+            sendCounts[RowOwner(firstRow+i)] +=
+              rowOffsets[i+1] - rowOffsets[i];
+        mpi::AllToAll
+        ( sendCounts.data(), 1, recvCounts.data(), 1, Grid().Comm() );
+        Int numLocal = 0;
+        for( const Int count : recvCounts )
+            numLocal += count;
+        const Int numRemote =
+          numEntries - baseOff - sendCounts[mpi::Rank(Grid().Comm())];
+        Reserve( numLocal, Min(batchSize,numRemote) );
+    }
+
+    // Expand the row indices of one batch at a time so that the temporary
+    // index storage is bounded by the batch size
+    vector<Int> batchRows;
+    Int i = 0;
+    for( Int batch=0; batch<numBatches; ++batch )
+    {
+        const Int off = Min(baseOff+batch*batchSize,numEntries);
+        const Int thisBatchSize = Min(batchSize,numEntries-off);
+        batchRows.resize( thisBatchSize );
+        for( Int e=0; e<thisBatchSize; ++e )
+        {
+            while( rowOffsets[i+1] <= off+e )
+                ++i;
+            batchRows[e] = firstRow + i;
+        }
+        for( Int e=0; e<thisBatchSize; ++e )
+            QueueUpdate( batchRows[e], cols[off+e], values[off+e] );
+        ExchangeRemoteUpdates( false );
+    }
+    // Sort and combine the local entries (and process any removals) once
+    ProcessQueues();
+}
+
 // Operator overloading
 // ====================
 
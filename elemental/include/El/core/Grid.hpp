@@ -12,14 +12,24 @@
 
 namespace El {
 
+class GridLayout;
+
 class Grid
 {
 public:
     explicit Grid
     ( mpi::Comm comm=mpi::COMM_WORLD, GridOrder order=COLUMN_MAJOR );
     explicit Grid( mpi::Comm comm, int height, GridOrder order=COLUMN_MAJOR );
+    // Lay the grid out over the nodes of the machine (see GridLayout)
+    explicit Grid
+    ( mpi::Comm comm, GridTopology topology, GridOrder order=COLUMN_MAJOR );
+    explicit Grid( const GridLayout& layout );
     ~Grid();
 
+    // The layout the grid was constructed from (or nullptr if it was not
+    // constructed from a GridLayout or this process is not in the grid)
+    const GridLayout* Layout() const EL_NO_EXCEPT;
+
     // Simple interface (simpler version of distributed-based interface)
     int Row() const EL_NO_RELEASE_EXCEPT; // MCRank()
     int Col() const EL_NO_RELEASE_EXCEPT; // MRRank()
@@ -146,6 +156,283 @@ private:
 bool operator==( const Grid& A, const Grid& B ) EL_NO_EXCEPT;
 bool operator!=( const Grid& A, const Grid& B ) EL_NO_EXCEPT;
 
+// Topology-aware process grids
+// =============================
+// By default, a grid of p processes is (as close as possible to) square and
+// the processes are placed onto it in the order of their ranks, regardless
+// of which of them share a node. A GridLayout instead queries which processes
+// share a node (and, with Open MPI, a socket) and chooses both the shape of
+// the grid and the placement of the processes so that either each column
+// communicator (used for [MC,*] redistributions, e.g., within the panel
+// factorizations of LU and QR) or each row communicator lies within a single
+// node, so that its traffic stays in shared memory.
+//
+// With p processes spread evenly over nodes of r processes each, keeping the
+// column communicators node-local requires a grid height which divides r,
+// and the divisor yielding the most nearly square grid is chosen (keeping
+// the row communicators node-local is analogous). GRID_TOPOLOGY_AUTO keeps
+// the column communicators node-local, as they are the more heavily used in
+// Elemental's factorizations, unless all of the processes share a node, the
+// nodes hold different numbers of processes, or the node-local grid would be
+// less than half as wide as the default one, in which case the default layout
+// is kept. Explicitly requested node-local layouts only fall back to the
+// default when the nodes are of different sizes. The chosen layout, along
+// with the reason for any fallback, is available from Description(), and a
+// grid constructed from a layout keeps a copy of it (see Grid::Layout).
+class GridLayout
+{
+public:
+    explicit GridLayout
+    ( mpi::Comm comm=mpi::COMM_WORLD,
+      GridTopology topology=GRID_TOPOLOGY_AUTO,
+      GridOrder order=COLUMN_MAJOR );
+    ~GridLayout();
+
+    // A reordered copy of the original communicator (owned by the layout)
+    mpi::Comm Comm() const EL_NO_EXCEPT { return comm_; }
+    int Height() const EL_NO_EXCEPT { return height_; }
+    int Width() const EL_NO_EXCEPT { return width_; }
+    GridOrder Order() const EL_NO_EXCEPT { return order_; }
+    // The topology that was chosen (never GRID_TOPOLOGY_AUTO)
+    GridTopology Topology() const EL_NO_EXCEPT { return topology_; }
+    int NumNodes() const EL_NO_EXCEPT { return numNodes_; }
+    // The maximum number of processes on a node
+    int NodeSize() const EL_NO_EXCEPT { return nodeSize_; }
+    const string& Description() const EL_NO_EXCEPT { return description_; }
+
+private:
+    mpi::Comm comm_;
+    int height_, width_;
+    GridOrder order_;
+    GridTopology topology_;
+    int numNodes_, nodeSize_;
+    string description_;
+
+    // Copies are only made by Grid and do not own a communicator
+    friend class Grid;
+    GridLayout( const GridLayout& layout );
+    const GridLayout& operator=( const GridLayout& );
+};
+
+namespace grid {
+
+inline string TopologyToString( GridTopology topology )
+{
+    switch( topology )
+    {
+    case GRID_TOPOLOGY_IGNORE:     return "GRID_TOPOLOGY_IGNORE";
+    case GRID_TOPOLOGY_LOCAL_COLS: return "GRID_TOPOLOGY_LOCAL_COLS";
+    case GRID_TOPOLOGY_LOCAL_ROWS: return "GRID_TOPOLOGY_LOCAL_ROWS";
+    default:                       return "GRID_TOPOLOGY_AUTO";
+    }
+}
+
+// The divisor of the node size yielding the most nearly square grid
+inline int NodeLocalDimension( int nodeSize, int gridSize )
+{
+    int bestDim = 1;
+    for( int dim=2; dim<=nodeSize; ++dim )
+        if( nodeSize % dim == 0 &&
+            Min(dim,gridSize/dim) > Min(bestDim,gridSize/bestDim) )
+            bestDim = dim;
+    return bestDim;
+}
+
+// The copy of the layout of a grid is attached to its VC communicator so
+// that it is freed along with the grid (whose storage cannot be extended)
+inline int DeleteLayout
+( MPI_Comm /*comm*/, int /*keyval*/, void* attribute, void* /*extraState*/ )
+{
+    delete static_cast<GridLayout*>(attribute);
+    return MPI_SUCCESS;
+}
+
+inline int LayoutKeyval()
+{
+    static int keyval = MPI_KEYVAL_INVALID;
+    if( keyval == MPI_KEYVAL_INVALID )
+        MPI_Comm_create_keyval
+        ( MPI_COMM_NULL_COPY_FN, DeleteLayout, &keyval, nullptr );
+    return keyval;
+}
+
+} // namespace grid
+
+inline GridLayout::GridLayout
+( mpi::Comm comm, GridTopology topology, GridOrder order )
+: order_(order), topology_(topology)
+{
+    EL_DEBUG_CSE
+    const int commRank = mpi::Rank( comm );
+    const int commSize = mpi::Size( comm );
+
+    // Group the processes by node
+    // ===========================
+    MPI_Comm nodeMPIComm;
+    MPI_Comm_split_type
+    ( comm.comm, MPI_COMM_TYPE_SHARED, commRank, MPI_INFO_NULL,
+      &nodeMPIComm );
+    mpi::Comm nodeComm( nodeMPIComm );
+    const int nodeRank = mpi::Rank( nodeComm );
+    const int nodeSize = mpi::Size( nodeComm );
+
+    // Number the nodes in the order of the ranks of their first processes
+    mpi::Comm leaderComm;
+    mpi::Split( comm, (nodeRank==0 ? 0 : 1), commRank, leaderComm );
+    int nodeInfo[2] = { 0, 0 };
+    if( nodeRank == 0 )
+    {
+        nodeInfo[0] = mpi::Rank( leaderComm );
+        nodeInfo[1] = mpi::Size( leaderComm );
+    }
+    mpi::Free( leaderComm );
+    mpi::Broadcast( nodeInfo, 2, 0, nodeComm );
+    const int nodeIndex = nodeInfo[0];
+    numNodes_ = nodeInfo[1];
+    nodeSize_ = mpi::AllReduce( nodeSize, mpi::MAX, comm );
+    const bool uniform =
+      ( mpi::AllReduce( nodeSize, mpi::MIN, comm ) == nodeSize_ );
+
+    // Order the processes of each node by socket (when it can be queried)
+    // so that node-local communicators which are smaller than a node are
+    // also socket-local when possible
+    int localRank = nodeRank;
+    string socketInfo;
+#ifdef OPEN_MPI
+    MPI_Comm socketMPIComm;
+    MPI_Comm_split_type
+    ( nodeComm.comm, OMPI_COMM_TYPE_SOCKET, nodeRank, MPI_INFO_NULL,
+      &socketMPIComm );
+    mpi::Comm socketComm( socketMPIComm );
+    const int socketLeader = mpi::AllReduce( nodeRank, mpi::MIN, socketComm );
+    const int socketKey = socketLeader*nodeSize + mpi::Rank(socketComm);
+    int numSockets = mpi::AllReduce( int(socketLeader==nodeRank), nodeComm );
+    mpi::Free( socketComm );
+    mpi::Comm orderedNodeComm;
+    mpi::Split( nodeComm, 0, socketKey, orderedNodeComm );
+    localRank = mpi::Rank( orderedNodeComm );
+    mpi::Free( orderedNodeComm );
+    mpi::Broadcast( numSockets, 0, comm );
+    socketInfo = BuildString(" (",numSockets," sockets on the first node)");
+#endif
+    mpi::Free( nodeComm );
+
+    // Choose the shape of the grid
+    // ============================
+    const int defaultHeight = Grid::DefaultHeight( commSize );
+    const int defaultMinDim = Min( defaultHeight, commSize/defaultHeight );
+    const int localDim = grid::NodeLocalDimension( nodeSize_, commSize );
+    const int localMinDim = Min( localDim, commSize/localDim );
+    string reason;
+    if( topology_ != GRID_TOPOLOGY_IGNORE && !uniform )
+    {
+        reason = "the nodes hold different numbers of processes";
+        topology_ = GRID_TOPOLOGY_IGNORE;
+    }
+    else if( topology_ == GRID_TOPOLOGY_AUTO )
+    {
+        if( numNodes_ == 1 )
+        {
+            reason = "all of the processes share a node";
+            topology_ = GRID_TOPOLOGY_IGNORE;
+        }
+        else if( 2*localMinDim < defaultMinDim )
+        {
+            reason = BuildString
+              ("a node-local grid would be only ",localMinDim," wide");
+            topology_ = GRID_TOPOLOGY_IGNORE;
+        }
+        else
+            topology_ = GRID_TOPOLOGY_LOCAL_COLS;
+    }
+
+    // Place the processes onto the grid
+    // =================================
+    // Processes are numbered node by node (and, within each node, socket by
+    // socket) and then assigned to the grid in column-major (row-major)
+    // order in order to keep each column (row) within a node.
+    const int nodeMajorRank = nodeIndex*nodeSize_ + localRank;
+    int row, col;
+    if( topology_ == GRID_TOPOLOGY_LOCAL_COLS )
+    {
+        height_ = localDim;
+        width_ = commSize / height_;
+        row = nodeMajorRank % height_;
+        col = nodeMajorRank / height_;
+    }
+    else if( topology_ == GRID_TOPOLOGY_LOCAL_ROWS )
+    {
+        width_ = localDim;
+        height_ = commSize / width_;
+        row = nodeMajorRank / width_;
+        col = nodeMajorRank % width_;
+    }
+    else
+    {
+        height_ = defaultHeight;
+        width_ = commSize / height_;
+        if( order_ == COLUMN_MAJOR )
+        {
+            row = commRank % height_;
+            col = commRank / height_;
+        }
+        else
+        {
+            row = commRank / width_;
+            col = commRank % width_;
+        }
+    }
+    const int key = ( order_ == COLUMN_MAJOR ? row + col*height_
+                                             : col + row*width_ );
+    mpi::Split( comm, 0, key, comm_ );
+
+    description_ = BuildString
+      (grid::TopologyToString(topology_),": ",height_," x ",width_,
+       " grid over ",numNodes_," node(s) of up to ",nodeSize_," processes",
+       socketInfo);
+    if( !reason.empty() )
+        description_ += BuildString(" (the default layout was kept since ",
+                                    reason,")");
+}
+
+inline GridLayout::GridLayout( const GridLayout& layout )
+: comm_(mpi::COMM_NULL),
+  height_(layout.height_), width_(layout.width_),
+  order_(layout.order_), topology_(layout.topology_),
+  numNodes_(layout.numNodes_), nodeSize_(layout.nodeSize_),
+  description_(layout.description_)
+{ }
+
+inline GridLayout::~GridLayout()
+{
+    if( comm_ != mpi::COMM_NULL && !mpi::Finalized() )
+        mpi::Free( comm_ );
+}
+
+inline Grid::Grid( mpi::Comm comm, GridTopology topology, GridOrder order )
+: Grid( GridLayout(comm,topology,order) )
+{ }
+
+inline Grid::Grid( const GridLayout& layout )
+: Grid( layout.Comm(), layout.Height(), layout.Order() )
+{
+    EL_DEBUG_CSE
+    if( VCComm() != mpi::COMM_NULL )
+        MPI_Comm_set_attr
+        ( VCComm().comm, grid::LayoutKeyval(), new GridLayout(layout) );
+}
+
+inline const GridLayout* Grid::Layout() const EL_NO_EXCEPT
+{
+    if( VCComm() == mpi::COMM_NULL )
+        return nullptr;
+    void* attribute;
+    int found;
+    MPI_Comm_get_attr
+    ( VCComm().comm, grid::LayoutKeyval(), &attribute, &found );
+    return found ? static_cast<const GridLayout*>(attribute) : nullptr;
+}
+
 inline void AssertSameGrids( const Grid& /*g1*/ ) { }
 
 inline void AssertSameGrids( const Grid& g1, const Grid& g2 )
@@ -0,0 +1,115 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_GRIDPARTITION_HPP
+#define EL_GRIDPARTITION_HPP
+
+namespace El {
+
+// A partition of the p owning processes of a grid into 'numParts' parts of
+// consecutive owning ranks, with part k consisting of the owning ranks
+// [(k p)/numParts,((k+1) p)/numParts), each of which is given its own grid.
+//
+// Every process of the parent's viewing communicator takes part in the
+// construction of every part's grid (and must take part in the destruction
+// of the partition) so that matrices may be moved between the parent grid
+// and any of the parts with copy::TranslateBetweenGrids.
+class GridPartition
+{
+public:
+    GridPartition( const Grid& g, int numParts );
+    ~GridPartition();
+
+    GridPartition( const GridPartition& partition ) = delete;
+    const GridPartition& operator=( const GridPartition& partition ) = delete;
+
+    int NumParts() const EL_NO_EXCEPT { return numParts_; }
+    // The part containing this process (or -1 if it does not own any of g)
+    int MyPart() const EL_NO_EXCEPT { return myPart_; }
+    int PartOffset( int k ) const EL_NO_EXCEPT
+    { return int((Int(k)*size_)/numParts_); }
+    int PartSize( int k ) const EL_NO_EXCEPT
+    { return PartOffset(k+1) - PartOffset(k); }
+    const Grid& PartGrid( int k ) const EL_NO_EXCEPT { return *grids_[k]; }
+
+    // Whether the partition was formed from a grid with the same viewing
+    // communicator, owning group, height, and ordering as g, so that it may
+    // be reused for matrices distributed over g
+    bool Partitions( const Grid& g ) const;
+
+private:
+    int numParts_, size_, myPart_;
+    int height_;
+    GridOrder order_;
+    mpi::Comm viewingComm_;
+    mpi::Group owningGroup_;
+    vector<mpi::Group> groups_;
+    vector<unique_ptr<Grid>> grids_;
+};
+
+inline GridPartition::GridPartition( const Grid& g, int numParts )
+: numParts_(numParts), size_(g.Size()), myPart_(-1),
+  height_(g.Height()), order_(g.Order())
+{
+    EL_DEBUG_CSE
+    if( numParts < 1 || numParts > size_ )
+        LogicError
+        ("Cannot partition ",size_," processes into ",numParts," parts");
+
+    // Keep duplicates of the parent's communicator and group so that the
+    // partition does not depend upon the lifetime of g
+    mpi::Dup( g.ViewingComm(), viewingComm_ );
+    vector<int> ranks(size_);
+    for( int q=0; q<size_; ++q )
+        ranks[q] = q;
+    mpi::Incl( g.OwningGroup(), size_, ranks.data(), owningGroup_ );
+
+    groups_.resize( numParts );
+    grids_.resize( numParts );
+    for( int k=0; k<numParts; ++k )
+    {
+        const int partSize = PartSize( k );
+        mpi::Incl
+        ( owningGroup_, partSize, &ranks[PartOffset(k)], groups_[k] );
+        grids_[k].reset
+        ( new Grid
+          ( viewingComm_, groups_[k], Grid::DefaultHeight(partSize),
+            order_ ) );
+    }
+
+    if( g.InGrid() )
+    {
+        const int rank = g.OwningRank();
+        myPart_ = 0;
+        while( PartOffset(myPart_+1) <= rank )
+            ++myPart_;
+    }
+}
+
+inline GridPartition::~GridPartition()
+{
+    // The grids must be freed before the groups they were constructed from
+    grids_.clear();
+    for( auto& group : groups_ )
+        mpi::Free( group );
+    mpi::Free( owningGroup_ );
+    mpi::Free( viewingComm_ );
+}
+
+inline bool GridPartition::Partitions( const Grid& g ) const
+{
+    EL_DEBUG_CSE
+    return g.Size() == size_ && g.Height() == height_ &&
+           g.Order() == order_ &&
+           mpi::Congruent( g.ViewingComm(), viewingComm_ ) &&
+           mpi::Congruent( g.OwningGroup(), owningGroup_ );
+}
+
+} // namespace El
+
+#endif // ifndef EL_GRIDPARTITION_HPP
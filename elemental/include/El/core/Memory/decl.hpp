@@ -11,6 +11,90 @@
 
 namespace El {
 
+// By default, Memory<G> obtains its buffers with new[] and releases them with
+// delete[]. With SetAllocator(POOL_ALLOCATOR), the buffers of packed
+// datatypes are instead drawn from a pool which rounds each request up to a
+// size class (within 12.5% of the request), aligns it to MemoryAlignment()
+// bytes, and caches released blocks for reuse so that repeatedly resized
+// workspaces avoid page faults and zeroing. With first touch enabled, each
+// newly obtained block is touched by the threads of an OpenMP parallel loop
+// so that its pages are placed on the NUMA nodes of the threads that will
+// later operate on them under a static schedule.
+//
+// Memory<G> keeps its layout: the pooled buffers are recognized by address
+// when they are released, and buffers obtained before the allocator was
+// switched are still released with delete[]. Other workspaces may use the
+// pool directly through PoolAllocate/PoolFree or through PoolAllocator,
+// e.g., with vector<T,PoolAllocator<T>>, in which case blocks must be
+// returned with the size they were requested with.
+namespace AllocatorNS {
+enum Allocator
+{
+    HEAP_ALLOCATOR,
+    POOL_ALLOCATOR
+};
+}
+using namespace AllocatorNS;
+
+struct MemoryStatistics
+{
+    size_t numRequests=0;       // blocks requested from the pool
+    size_t numPoolHits=0;       // requests served from the pool's cache
+    size_t numSystemAllocs=0;   // blocks obtained from the system
+    size_t numSystemFrees=0;    // blocks returned to the system
+    size_t bytesInUse=0;
+    size_t peakBytesInUse=0;
+    size_t bytesCached=0;
+};
+
+void SetAllocator( Allocator allocator );
+Allocator GetAllocator();
+
+void* PoolAllocate( size_t numBytes );
+// Releasing a null pointer has no effect
+void PoolFree( void* block, size_t numBytes );
+
+// The alignment (in bytes) of pooled blocks; it must be a power of two,
+// and 2 MB may be used to favor transparent huge pages
+void SetMemoryAlignment( size_t alignment );
+size_t MemoryAlignment();
+
+void SetFirstTouch( bool firstTouch );
+bool FirstTouch();
+
+// An upper bound on the number of bytes held in the pool's cache
+void SetMemoryPoolLimit( size_t bytes );
+size_t MemoryPoolLimit();
+
+// Return every cached block to the system
+void ReleaseCachedMemory();
+
+MemoryStatistics GetMemoryStatistics();
+void ResetMemoryStatistics();
+void PrintMemoryStatistics( ostream& os=cout );
+
+template<typename T>
+struct PoolAllocator
+{
+    typedef T value_type;
+
+    PoolAllocator() EL_NO_EXCEPT { }
+    template<typename S>
+    PoolAllocator( const PoolAllocator<S>& ) EL_NO_EXCEPT { }
+
+    T* allocate( size_t n )
+    { return static_cast<T*>(PoolAllocate( n*sizeof(T) )); }
+    void deallocate( T* ptr, size_t n ) EL_NO_EXCEPT
+    { PoolFree( ptr, n*sizeof(T) ); }
+};
+
+template<typename T,typename S>
+bool operator==( const PoolAllocator<T>&, const PoolAllocator<S>& )
+{ return true; }
+template<typename T,typename S>
+bool operator!=( const PoolAllocator<T>&, const PoolAllocator<S>& )
+{ return false; }
+
 template<typename G>
 class Memory
 {
@@ -9,9 +9,297 @@
 
 namespace El {
 
+namespace memory {
+
+struct PoolState
+{
+    std::mutex mutex;
+    // The settings may be read without the lock
+    std::atomic<Allocator> allocator{HEAP_ALLOCATOR};
+    std::atomic<size_t> alignment{64};
+    std::atomic<bool> firstTouch{false};
+    std::atomic<size_t> cacheLimit{std::numeric_limits<size_t>::max()};
+    // Cached blocks, keyed by their (rounded) size in bytes
+    std::map<size_t,vector<void*>> cache;
+    // The blocks currently held by Memory<G> objects (and their requested
+    // sizes), which are counted so that the lookup can be skipped (without
+    // locking) whenever there are none
+    std::unordered_map<void*,size_t> memoryBlocks;
+    std::atomic<size_t> numMemoryBlocks{0};
+    MemoryStatistics stats;
+};
+
+// The state is intentionally never destroyed so that matrices with static
+// storage duration can still release their buffers during program exit
+inline PoolState& State()
+{
+    static PoolState* state = new PoolState;
+    return *state;
+}
+
+// Round up to one of eight evenly-spaced sizes between consecutive powers of
+// two so that at most 12.5% of each block is wasted
+inline size_t SizeClass( size_t numBytes )
+{
+    const size_t minBytes = 256;
+    if( numBytes <= minBytes )
+        return minBytes;
+    size_t power = minBytes;
+    while( power < numBytes )
+        power <<= 1;
+    const size_t step = power / 16;
+    return ((numBytes+step-1)/step)*step;
+}
+
+// The unaligned address returned by the system is stored immediately before
+// the aligned block
+inline void* SystemAllocate( size_t numBytes, size_t alignment )
+{
+    const size_t padding = alignment + sizeof(void*);
+    char* raw = static_cast<char*>(::operator new( numBytes+padding ));
+    size_t addr = reinterpret_cast<size_t>(raw) + sizeof(void*);
+    addr = ((addr+alignment-1)/alignment)*alignment;
+    void** block = reinterpret_cast<void**>(addr);
+    block[-1] = raw;
+    return block;
+}
+
+inline void SystemFree( void* block )
+{ ::operator delete( static_cast<void**>(block)[-1] ); }
+
+inline void TouchPages( void* block, size_t numBytes )
+{
+    const size_t pageSize = 4096;
+    char* bytes = static_cast<char*>(block);
+    const Int numPages = (numBytes+pageSize-1) / pageSize;
+    EL_PARALLEL_FOR
+    for( Int page=0; page<numPages; ++page )
+        bytes[page*pageSize] = 0;
+}
+
+inline void RecordAllocation( PoolState& state, size_t numBytes )
+{
+    auto& stats = state.stats;
+    ++stats.numRequests;
+    stats.bytesInUse += numBytes;
+    stats.peakBytesInUse = Max( stats.peakBytesInUse, stats.bytesInUse );
+}
+
+inline void RecordDeallocation( PoolState& state, size_t numBytes )
+{
+    auto& stats = state.stats;
+    stats.bytesInUse -= Min( stats.bytesInUse, numBytes );
+}
+
+inline void ReleaseCache( PoolState& state )
+{
+    for( auto& entry : state.cache )
+    {
+        for( void* block : entry.second )
+        {
+            SystemFree( block );
+            ++state.stats.numSystemFrees;
+        }
+    }
+    state.cache.clear();
+    state.stats.bytesCached = 0;
+}
+
+inline void* Allocate( size_t numBytes )
+{
+    auto& state = State();
+    const size_t blockBytes = SizeClass( numBytes );
+    bool fresh = false;
+    void* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock( state.mutex );
+        RecordAllocation( state, blockBytes );
+        auto it = state.cache.find( blockBytes );
+        if( it != state.cache.end() && !it->second.empty() )
+        {
+            block = it->second.back();
+            it->second.pop_back();
+            state.stats.bytesCached -= blockBytes;
+            ++state.stats.numPoolHits;
+        }
+        else
+        {
+            try
+            {
+                block = SystemAllocate( blockBytes, state.alignment );
+            }
+            catch( std::bad_alloc& )
+            {
+                // Retry after handing all cached blocks back to the system
+                ReleaseCache( state );
+                block = SystemAllocate( blockBytes, state.alignment );
+            }
+            ++state.stats.numSystemAllocs;
+            fresh = true;
+        }
+    }
+    if( fresh && FirstTouch() )
+        TouchPages( block, blockBytes );
+    return block;
+}
+
+inline void Free( void* block, size_t numBytes )
+{
+    if( block == nullptr )
+        return;
+    auto& state = State();
+    const size_t blockBytes = SizeClass( numBytes );
+    std::lock_guard<std::mutex> lock( state.mutex );
+    RecordDeallocation( state, blockBytes );
+    // Blocks aligned for a previous alignment setting are not reused
+    const bool aligned =
+      reinterpret_cast<size_t>(block) % state.alignment == 0;
+    if( aligned && state.stats.bytesCached+blockBytes <= state.cacheLimit )
+    {
+        state.cache[blockBytes].push_back( block );
+        state.stats.bytesCached += blockBytes;
+    }
+    else
+    {
+        SystemFree( block );
+        ++state.stats.numSystemFrees;
+    }
+}
+
+inline void* AllocateForMemory( size_t numBytes )
+{
+    auto& state = State();
+    void* block = Allocate( numBytes );
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.memoryBlocks[block] = numBytes;
+    ++state.numMemoryBlocks;
+    return block;
+}
+
+// Return the block to the pool if it was obtained from AllocateForMemory,
+// and otherwise report that it must be released with delete[]
+inline bool FreeFromMemory( void* block )
+{
+    auto& state = State();
+    if( block == nullptr || state.numMemoryBlocks == 0 )
+        return false;
+    size_t numBytes;
+    {
+        std::lock_guard<std::mutex> lock( state.mutex );
+        auto it = state.memoryBlocks.find( block );
+        if( it == state.memoryBlocks.end() )
+            return false;
+        numBytes = it->second;
+        state.memoryBlocks.erase( it );
+        --state.numMemoryBlocks;
+    }
+    Free( block, numBytes );
+    return true;
+}
+
+} // namespace memory
+
+inline void SetAllocator( Allocator allocator )
+{ memory::State().allocator = allocator; }
+
+inline Allocator GetAllocator()
+{ return memory::State().allocator; }
+
+inline void* PoolAllocate( size_t numBytes )
+{ return memory::Allocate( numBytes ); }
+
+inline void PoolFree( void* block, size_t numBytes )
+{ memory::Free( block, numBytes ); }
+
+inline void SetMemoryAlignment( size_t alignment )
+{
+    if( alignment < sizeof(void*) || (alignment & (alignment-1)) != 0 )
+        LogicError
+        ("Alignment must be a power of two which is at least ",sizeof(void*));
+    auto& state = memory::State();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    if( alignment != state.alignment )
+    {
+        memory::ReleaseCache( state );
+        state.alignment = alignment;
+    }
+}
+
+inline size_t MemoryAlignment()
+{ return memory::State().alignment; }
+
+inline void SetFirstTouch( bool firstTouch )
+{ memory::State().firstTouch = firstTouch; }
+
+inline bool FirstTouch()
+{ return memory::State().firstTouch; }
+
+inline void SetMemoryPoolLimit( size_t bytes )
+{
+    auto& state = memory::State();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.cacheLimit = bytes;
+    if( state.stats.bytesCached > bytes )
+        memory::ReleaseCache( state );
+}
+
+inline size_t MemoryPoolLimit()
+{ return memory::State().cacheLimit; }
+
+inline void ReleaseCachedMemory()
+{
+    auto& state = memory::State();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    memory::ReleaseCache( state );
+}
+
+inline MemoryStatistics GetMemoryStatistics()
+{
+    auto& state = memory::State();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    return state.stats;
+}
+
+inline void ResetMemoryStatistics()
+{
+    auto& state = memory::State();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    const size_t bytesInUse = state.stats.bytesInUse;
+    const size_t bytesCached = state.stats.bytesCached;
+    state.stats = MemoryStatistics();
+    state.stats.bytesInUse = bytesInUse;
+    state.stats.peakBytesInUse = bytesInUse;
+    state.stats.bytesCached = bytesCached;
+}
+
+inline void PrintMemoryStatistics( ostream& os )
+{
+    const auto stats = GetMemoryStatistics();
+    os << "Memory statistics on process " << mpi::Rank() << ":\n"
+       << "  requests:           " << stats.numRequests << "\n"
+       << "  pool hits:          " << stats.numPoolHits << "\n"
+       << "  system allocations: " << stats.numSystemAllocs << "\n"
+       << "  system frees:       " << stats.numSystemFrees << "\n"
+       << "  bytes in use:       " << stats.bytesInUse << "\n"
+       << "  peak bytes in use:  " << stats.peakBytesInUse << "\n"
+       << "  bytes cached:       " << stats.bytesCached << endl;
+}
+
 namespace {
 
-template<typename G>
+// Only packed datatypes, which require no construction, may be pooled
+template<typename G,
+         typename=EnableIf<IsPacked<G>>>
+static G* New( size_t size )
+{
+    if( GetAllocator() == POOL_ALLOCATOR )
+        return static_cast<G*>(memory::AllocateForMemory( size*sizeof(G) ));
+    return new G[size];
+}
+
+template<typename G,
+         typename=DisableIf<IsPacked<G>>,
+         typename=void>
 static G* New( size_t size )
 {
     return new G[size];
@@ -20,7 +308,8 @@ static G* New( size_t size )
 template<typename G>
 static void Delete( G*& ptr )
 {
-    delete[] ptr;
+    if( !memory::FreeFromMemory( ptr ) )
+        delete[] ptr;
     ptr = nullptr;
 }
 
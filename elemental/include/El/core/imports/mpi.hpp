@@ -728,6 +728,58 @@ void AllGather
 ( const T* sbuf, int sc,
         T* rbuf, int rc, Comm comm ) EL_NO_RELEASE_EXCEPT;
 
+// Non-blocking all-gather
+// -----------------------
+// Unlike the other wrappers, these are defined inline. If nonblocking
+// collectives are unavailable, or the datatype is not packed, a blocking
+// all-gather is performed and a null request is returned.
+template<typename Real,
+         typename=EnableIf<IsPacked<Real>>>
+void IAllGather
+( const Real* sbuf, int sc,
+        Real* rbuf, int rc, Comm comm, Request<Real>& request )
+{
+    request.receivingPacked = false;
+#if defined(EL_HAVE_MPI3_NONBLOCKING_COLLECTIVES)
+    MPI_Iallgather
+    ( sbuf, sc, TypeMap<Real>(), rbuf, rc, TypeMap<Real>(), comm.comm,
+      &request.backend );
+#elif defined(EL_HAVE_MPIX_NONBLOCKING_COLLECTIVES)
+    MPIX_Iallgather
+    ( const_cast<Real*>(sbuf), sc, TypeMap<Real>(),
+      rbuf, rc, TypeMap<Real>(), comm.comm, &request.backend );
+#else
+    AllGather( sbuf, sc, rbuf, rc, comm );
+    request.backend = MPI_REQUEST_NULL;
+#endif
+}
+template<typename Real,
+         typename=EnableIf<IsPacked<Real>>>
+void IAllGather
+( const Complex<Real>* sbuf, int sc,
+        Complex<Real>* rbuf, int rc, Comm comm,
+  Request<Complex<Real>>& request )
+{
+    // Transmit each complex number as a pair of real numbers
+    Request<Real> realRequest;
+    IAllGather
+    ( reinterpret_cast<const Real*>(sbuf), 2*sc,
+      reinterpret_cast<Real*>(rbuf), 2*rc, comm, realRequest );
+    request.receivingPacked = false;
+    request.backend = realRequest.backend;
+}
+template<typename T,
+         typename=DisableIf<IsPacked<T>>,
+         typename=void>
+void IAllGather
+( const T* sbuf, int sc,
+        T* rbuf, int rc, Comm comm, Request<T>& request )
+{
+    AllGather( sbuf, sc, rbuf, rc, comm );
+    request.receivingPacked = false;
+    request.backend = MPI_REQUEST_NULL;
+}
+
 // AllGather with variable recv sizes
 // ----------------------------------
 template<typename Real,
@@ -0,0 +1,727 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_IMPORTS_MPI_PROFILE_HPP
+#define EL_IMPORTS_MPI_PROFILE_HPP
+
+// An opt-in profiling layer for the MPI calls made by Elemental
+// =============================================================
+// Statistics are accumulated per (operation, communicator, call site), where
+// the call site is the innermost label pushed by the calling thread with
+// mpi::PushCallSite (or an mpi::CallSite object). Recording is enabled with
+// mpi::EnableProfiling.
+//
+// The calls are captured through the standard PMPI profiling interface: in
+// exactly one translation unit of the application, define
+// EL_MPI_PROFILE_INTERCEPT before including El.hpp. That unit then provides
+// MPI_Allreduce, MPI_Alltoall, MPI_Bcast, ..., the point-to-point routines
+// (MPI_Send, MPI_Recv, MPI_Isend, MPI_Irecv, ...), and, if available, the
+// MPI-3 nonblocking collectives (MPI_Iallgather, MPI_Ibcast, ...), which
+// record each call before forwarding to the corresponding PMPI routine, so
+// that the calls made from within Elemental's mpi wrappers are captured
+// without recompiling Elemental. Only the initiation of a nonblocking call is
+// timed, as its completion is not associated with an operation.
+// If a JSON file was requested with mpi::SetProfileJSONFile, each process
+// writes its statistics to "<basename>-<rank>.json" within MPI_Finalize.
+//
+// When imbalance measurement is requested, each blocking collective is
+// preceded by a barrier over its communicator, and the time spent in that
+// barrier (i.e., waiting for the last process to arrive) is reported
+// separately from the time spent within the collective itself.
+
+namespace El {
+namespace mpi {
+
+struct ProfileStatistics
+{
+    Int numCalls=0;
+    double bytes=0;     // bytes sent by this process (receives count none)
+    double time=0;      // seconds spent within the calls
+    double waitTime=0;  // seconds spent waiting at entry (see above)
+};
+
+struct ProfileKey
+{
+    string operation;
+    string comm;
+    string callSite;
+
+    bool operator<( const ProfileKey& other ) const
+    {
+        if( operation != other.operation )
+            return operation < other.operation;
+        if( comm != other.comm )
+            return comm < other.comm;
+        return callSite < other.callSite;
+    }
+};
+
+namespace profile {
+
+struct State
+{
+    std::mutex mutex;
+    // Read without the lock by every intercepted call
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> measureImbalance{false};
+    string jsonBasename;
+    // Handles may be reused once freed, so names are dropped in MPI_Comm_free
+    std::map<MPI_Comm,string> commNames;
+    Int numCommsNamed=0;
+    std::map<ProfileKey,ProfileStatistics> stats;
+};
+
+// Never destroyed so that calls made during program exit can be recorded
+inline State& GetState()
+{
+    static State* state = new State;
+    return *state;
+}
+
+// Each thread labels its own calls
+inline vector<string>& CallSites()
+{
+    static thread_local vector<string> callSites;
+    return callSites;
+}
+
+// Name each communicator by its MPI name (if any), its size, and the order in
+// which it was first seen (or first seen since its handle was last freed)
+inline string CommName( State& state, MPI_Comm comm )
+{
+    auto it = state.commNames.find( comm );
+    if( it != state.commNames.end() )
+        return it->second;
+    char name[MPI_MAX_OBJECT_NAME];
+    int nameLength = 0;
+    PMPI_Comm_get_name( comm, name, &nameLength );
+    int size;
+    PMPI_Comm_size( comm, &size );
+    const string commName =
+      ( nameLength > 0 ?
+        BuildString(string(name,nameLength),"[",size,"]") :
+        BuildString("comm",state.numCommsNamed++,"[",size,"]") );
+    state.commNames[comm] = commName;
+    return commName;
+}
+
+inline void ForgetComm( State& state, MPI_Comm comm )
+{
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.commNames.erase( comm );
+}
+
+inline string EscapeJSON( const string& str )
+{
+    string escaped;
+    for( const char c : str )
+    {
+        if( c == '"' || c == '\\' )
+            escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+} // namespace profile
+
+inline void EnableProfiling( bool measureImbalance=false )
+{
+    auto& state = profile::GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.enabled = true;
+    state.measureImbalance = measureImbalance;
+}
+
+inline void DisableProfiling()
+{
+    auto& state = profile::GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.enabled = false;
+}
+
+inline bool Profiling() { return profile::GetState().enabled; }
+
+inline bool ProfilingImbalance()
+{
+    const auto& state = profile::GetState();
+    return state.enabled && state.measureImbalance;
+}
+
+inline void PushCallSite( const string& callSite )
+{ profile::CallSites().push_back( callSite ); }
+
+inline void PopCallSite()
+{
+    auto& callSites = profile::CallSites();
+    if( callSites.empty() )
+        LogicError("Attempted to pop an empty MPI call-site stack");
+    callSites.pop_back();
+}
+
+// Label the MPI calls made during the lifetime of this object
+class CallSite
+{
+public:
+    CallSite( const string& callSite ) { PushCallSite( callSite ); }
+    ~CallSite() { PopCallSite(); }
+};
+
+inline void RecordCall
+( const char* operation, MPI_Comm comm,
+  double bytes, double time, double waitTime=0 )
+{
+    const auto& callSites = profile::CallSites();
+    auto& state = profile::GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    if( !state.enabled )
+        return;
+    ProfileKey key;
+    key.operation = operation;
+    key.comm = profile::CommName( state, comm );
+    key.callSite = ( callSites.empty() ? "" : callSites.back() );
+    auto& stats = state.stats[key];
+    ++stats.numCalls;
+    stats.bytes += bytes;
+    stats.time += time;
+    stats.waitTime += waitTime;
+}
+
+inline std::map<ProfileKey,ProfileStatistics> ProfileSummary()
+{
+    auto& state = profile::GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    return state.stats;
+}
+
+inline void ResetProfile()
+{
+    auto& state = profile::GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.stats.clear();
+}
+
+inline void PrintProfile( ostream& os=cout )
+{
+    const auto summary = ProfileSummary();
+    int rank = 0;
+    PMPI_Comm_rank( MPI_COMM_WORLD, &rank );
+    ostringstream msg;
+    msg << "MPI profile of process " << rank << ":\n";
+    for( const auto& entry : summary )
+    {
+        const auto& key = entry.first;
+        const auto& stats = entry.second;
+        msg << "  " << key.operation << " on " << key.comm;
+        if( !key.callSite.empty() )
+            msg << " from " << key.callSite;
+        msg << ": " << stats.numCalls << " calls, " << stats.bytes
+            << " bytes, " << stats.time << " s";
+        if( stats.waitTime > 0 )
+            msg << " (+ " << stats.waitTime << " s waiting)";
+        msg << "\n";
+    }
+    os << msg.str();
+}
+
+inline void WriteProfileJSON( const string& filename )
+{
+    const auto summary = ProfileSummary();
+    int rank = 0;
+    PMPI_Comm_rank( MPI_COMM_WORLD, &rank );
+    ofstream file( filename.c_str() );
+    if( !file.is_open() )
+        RuntimeError("Could not open ",filename);
+    file << "{\n  \"rank\": " << rank << ",\n  \"calls\": [";
+    bool first = true;
+    for( const auto& entry : summary )
+    {
+        const auto& key = entry.first;
+        const auto& stats = entry.second;
+        file << ( first ? "\n" : ",\n" )
+             << "    {\"operation\": \""
+             << profile::EscapeJSON(key.operation) << "\", "
+             << "\"comm\": \"" << profile::EscapeJSON(key.comm) << "\", "
+             << "\"callSite\": \"" << profile::EscapeJSON(key.callSite)
+             << "\", "
+             << "\"numCalls\": " << stats.numCalls << ", "
+             << "\"bytes\": " << stats.bytes << ", "
+             << "\"time\": " << stats.time << ", "
+             << "\"waitTime\": " << stats.waitTime << "}";
+        first = false;
+    }
+    file << "\n  ]\n}\n";
+}
+
+// Request that each process write "<basename>-<rank>.json" in MPI_Finalize
+// (only effective when EL_MPI_PROFILE_INTERCEPT was defined in some unit)
+inline void SetProfileJSONFile( const string& basename )
+{
+    auto& state = profile::GetState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+    state.jsonBasename = basename;
+}
+
+namespace profile {
+
+inline int TypeSize( MPI_Datatype type )
+{
+    int size;
+    PMPI_Type_size( type, &size );
+    return size;
+}
+
+inline double SumCounts( const int* counts, MPI_Comm comm )
+{
+    int size;
+    PMPI_Comm_size( comm, &size );
+    double sum = 0;
+    for( int q=0; q<size; ++q )
+        sum += counts[q];
+    return sum;
+}
+
+// Time a collective (and, optionally, the wait at its entry)
+template<typename Call>
+int Collective
+( const char* operation, MPI_Comm comm, double bytes, Call call )
+{
+    if( !Profiling() )
+        return call();
+    double waitTime = 0;
+    if( ProfilingImbalance() )
+    {
+        const double waitStart = PMPI_Wtime();
+        PMPI_Barrier( comm );
+        waitTime = PMPI_Wtime() - waitStart;
+    }
+    const double start = PMPI_Wtime();
+    const int result = call();
+    RecordCall( operation, comm, bytes, PMPI_Wtime()-start, waitTime );
+    return result;
+}
+
+// Time a point-to-point or nonblocking call (without a preceding barrier)
+template<typename Call>
+int Timed( const char* operation, MPI_Comm comm, double bytes, Call call )
+{
+    if( !Profiling() )
+        return call();
+    const double start = PMPI_Wtime();
+    const int result = call();
+    RecordCall( operation, comm, bytes, PMPI_Wtime()-start );
+    return result;
+}
+
+} // namespace profile
+
+} // namespace mpi
+} // namespace El
+
+#ifdef EL_MPI_PROFILE_INTERCEPT
+extern "C" {
+
+int MPI_Allreduce
+( const void* sendbuf, void* recvbuf, int count,
+  MPI_Datatype datatype, MPI_Op op, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "AllReduce", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Allreduce
+              ( sendbuf, recvbuf, count, datatype, op, comm ); } );
+}
+
+int MPI_Reduce
+( const void* sendbuf, void* recvbuf, int count,
+  MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "Reduce", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Reduce
+              ( sendbuf, recvbuf, count, datatype, op, root, comm ); } );
+}
+
+int MPI_Bcast
+( void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "Broadcast", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Bcast( buffer, count, datatype, root, comm ); } );
+}
+
+int MPI_Allgather
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "AllGather", comm, double(sendcount)*TypeSize(sendtype),
+      [&]() { return PMPI_Allgather
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcount, recvtype, comm ); } );
+}
+
+int MPI_Allgatherv
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, const int recvcounts[], const int displs[],
+  MPI_Datatype recvtype, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "AllGather", comm, double(sendcount)*TypeSize(sendtype),
+      [&]() { return PMPI_Allgatherv
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcounts, displs, recvtype, comm ); } );
+}
+
+int MPI_Gather
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype,
+  int root, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "Gather", comm, double(sendcount)*TypeSize(sendtype),
+      [&]() { return PMPI_Gather
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcount, recvtype, root, comm ); } );
+}
+
+int MPI_Gatherv
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, const int recvcounts[], const int displs[],
+  MPI_Datatype recvtype, int root, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "Gather", comm, double(sendcount)*TypeSize(sendtype),
+      [&]() { return PMPI_Gatherv
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcounts, displs, recvtype, root, comm ); } );
+}
+
+int MPI_Scatter
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype,
+  int root, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    int rank;
+    PMPI_Comm_rank( comm, &rank );
+    int size;
+    PMPI_Comm_size( comm, &size );
+    const double bytes =
+      ( rank == root ? double(size)*sendcount*TypeSize(sendtype) : 0. );
+    return Collective
+    ( "Scatter", comm, bytes,
+      [&]() { return PMPI_Scatter
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcount, recvtype, root, comm ); } );
+}
+
+int MPI_Alltoall
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    int size;
+    PMPI_Comm_size( comm, &size );
+    return Collective
+    ( "AllToAll", comm, double(size)*sendcount*TypeSize(sendtype),
+      [&]() { return PMPI_Alltoall
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcount, recvtype, comm ); } );
+}
+
+int MPI_Alltoallv
+( const void* sendbuf, const int sendcounts[], const int sdispls[],
+  MPI_Datatype sendtype,
+        void* recvbuf, const int recvcounts[], const int rdispls[],
+  MPI_Datatype recvtype, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "AllToAll", comm, SumCounts(sendcounts,comm)*TypeSize(sendtype),
+      [&]() { return PMPI_Alltoallv
+              ( sendbuf, sendcounts, sdispls, sendtype,
+                recvbuf, recvcounts, rdispls, recvtype, comm ); } );
+}
+
+int MPI_Reduce_scatter
+( const void* sendbuf, void* recvbuf, const int recvcounts[],
+  MPI_Datatype datatype, MPI_Op op, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Collective
+    ( "ReduceScatter", comm, SumCounts(recvcounts,comm)*TypeSize(datatype),
+      [&]() { return PMPI_Reduce_scatter
+              ( sendbuf, recvbuf, recvcounts, datatype, op, comm ); } );
+}
+
+int MPI_Reduce_scatter_block
+( const void* sendbuf, void* recvbuf, int recvcount,
+  MPI_Datatype datatype, MPI_Op op, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    int size;
+    PMPI_Comm_size( comm, &size );
+    return Collective
+    ( "ReduceScatter", comm, double(size)*recvcount*TypeSize(datatype),
+      [&]() { return PMPI_Reduce_scatter_block
+              ( sendbuf, recvbuf, recvcount, datatype, op, comm ); } );
+}
+
+int MPI_Barrier( MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "Barrier", comm, 0., [&]() { return PMPI_Barrier( comm ); } );
+}
+
+// Point-to-point
+// --------------
+
+int MPI_Send
+( const void* buf, int count, MPI_Datatype datatype,
+  int dest, int tag, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "Send", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Send( buf, count, datatype, dest, tag, comm ); } );
+}
+
+int MPI_Ssend
+( const void* buf, int count, MPI_Datatype datatype,
+  int dest, int tag, MPI_Comm comm )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "SSend", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Ssend( buf, count, datatype, dest, tag, comm ); } );
+}
+
+int MPI_Recv
+( void* buf, int count, MPI_Datatype datatype,
+  int source, int tag, MPI_Comm comm, MPI_Status* status )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "Recv", comm, 0.,
+      [&]() { return PMPI_Recv
+              ( buf, count, datatype, source, tag, comm, status ); } );
+}
+
+int MPI_Sendrecv
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+  int dest, int sendtag,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype,
+  int source, int recvtag, MPI_Comm comm, MPI_Status* status )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "SendRecv", comm, double(sendcount)*TypeSize(sendtype),
+      [&]() { return PMPI_Sendrecv
+              ( sendbuf, sendcount, sendtype, dest, sendtag,
+                recvbuf, recvcount, recvtype, source, recvtag, comm,
+                status ); } );
+}
+
+int MPI_Sendrecv_replace
+( void* buf, int count, MPI_Datatype datatype,
+  int dest, int sendtag, int source, int recvtag,
+  MPI_Comm comm, MPI_Status* status )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "SendRecv", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Sendrecv_replace
+              ( buf, count, datatype, dest, sendtag, source, recvtag, comm,
+                status ); } );
+}
+
+int MPI_Isend
+( const void* buf, int count, MPI_Datatype datatype,
+  int dest, int tag, MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "ISend", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Isend
+              ( buf, count, datatype, dest, tag, comm, request ); } );
+}
+
+int MPI_Irsend
+( const void* buf, int count, MPI_Datatype datatype,
+  int dest, int tag, MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IRSend", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Irsend
+              ( buf, count, datatype, dest, tag, comm, request ); } );
+}
+
+int MPI_Issend
+( const void* buf, int count, MPI_Datatype datatype,
+  int dest, int tag, MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "ISSend", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Issend
+              ( buf, count, datatype, dest, tag, comm, request ); } );
+}
+
+int MPI_Irecv
+( void* buf, int count, MPI_Datatype datatype,
+  int source, int tag, MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IRecv", comm, 0.,
+      [&]() { return PMPI_Irecv
+              ( buf, count, datatype, source, tag, comm, request ); } );
+}
+
+// Nonblocking collectives
+// -----------------------
+#ifdef EL_HAVE_MPI3_NONBLOCKING_COLLECTIVES
+
+int MPI_Ibarrier( MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IBarrier", comm, 0.,
+      [&]() { return PMPI_Ibarrier( comm, request ); } );
+}
+
+int MPI_Iallreduce
+( const void* sendbuf, void* recvbuf, int count,
+  MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IAllReduce", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Iallreduce
+              ( sendbuf, recvbuf, count, datatype, op, comm, request ); } );
+}
+
+int MPI_Ireduce
+( const void* sendbuf, void* recvbuf, int count,
+  MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm,
+  MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IReduce", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Ireduce
+              ( sendbuf, recvbuf, count, datatype, op, root, comm,
+                request ); } );
+}
+
+int MPI_Ibcast
+( void* buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm,
+  MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IBroadcast", comm, double(count)*TypeSize(datatype),
+      [&]() { return PMPI_Ibcast
+              ( buffer, count, datatype, root, comm, request ); } );
+}
+
+int MPI_Iallgather
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm,
+  MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IAllGather", comm, double(sendcount)*TypeSize(sendtype),
+      [&]() { return PMPI_Iallgather
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcount, recvtype, comm, request ); } );
+}
+
+int MPI_Igather
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype,
+  int root, MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IGather", comm, double(sendcount)*TypeSize(sendtype),
+      [&]() { return PMPI_Igather
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcount, recvtype, root, comm, request ); } );
+}
+
+int MPI_Ialltoall
+( const void* sendbuf, int sendcount, MPI_Datatype sendtype,
+        void* recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm,
+  MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    int size;
+    PMPI_Comm_size( comm, &size );
+    return Timed
+    ( "IAllToAll", comm, double(size)*sendcount*TypeSize(sendtype),
+      [&]() { return PMPI_Ialltoall
+              ( sendbuf, sendcount, sendtype,
+                recvbuf, recvcount, recvtype, comm, request ); } );
+}
+
+int MPI_Ialltoallv
+( const void* sendbuf, const int sendcounts[], const int sdispls[],
+  MPI_Datatype sendtype,
+        void* recvbuf, const int recvcounts[], const int rdispls[],
+  MPI_Datatype recvtype, MPI_Comm comm, MPI_Request* request )
+{
+    using namespace El::mpi::profile;
+    return Timed
+    ( "IAllToAll", comm, SumCounts(sendcounts,comm)*TypeSize(sendtype),
+      [&]() { return PMPI_Ialltoallv
+              ( sendbuf, sendcounts, sdispls, sendtype,
+                recvbuf, recvcounts, rdispls, recvtype, comm, request ); } );
+}
+
+#endif // ifdef EL_HAVE_MPI3_NONBLOCKING_COLLECTIVES
+
+int MPI_Comm_free( MPI_Comm* comm )
+{
+    // The handle may be reused by a later communicator
+    El::mpi::profile::ForgetComm( El::mpi::profile::GetState(), *comm );
+    return PMPI_Comm_free( comm );
+}
+
+int MPI_Finalize()
+{
+    auto& state = El::mpi::profile::GetState();
+    std::string jsonBasename;
+    {
+        std::lock_guard<std::mutex> lock( state.mutex );
+        jsonBasename = state.jsonBasename;
+    }
+    if( !jsonBasename.empty() )
+    {
+        int rank;
+        PMPI_Comm_rank( MPI_COMM_WORLD, &rank );
+        El::mpi::WriteProfileJSON
+        ( El::BuildString(jsonBasename,"-",rank,".json") );
+    }
+    return PMPI_Finalize();
+}
+
+} // extern "C"
+#endif // ifdef EL_MPI_PROFILE_INTERCEPT
+
+#endif // ifndef EL_IMPORTS_MPI_PROFILE_HPP
@@ -99,6 +99,48 @@ F SampleBall( const F& center=F(0), const Base<F>& radius=Base<F>(1) );
 template<typename Real,typename=EnableIf<IsReal<Real>>> 
 Real SampleBall( const Real& center=Real(0), const Real& radius=Real(1) );
 
+// A counter-based random number generator
+// =======================================
+// Philox4x32-10, from
+//
+//   John K. Salmon, Mark A. Moraes, Ron O. Dror, and David E. Shaw,
+//   "Parallel random numbers: as easy as 1, 2, 3", SC11.
+//
+// Each call maps a 128-bit counter, formed from a global matrix index (i,j)
+// and a draw number k < 256, and the 64-bit seed to four independent 32-bit
+// words. Since there is no state to advance, entries can be generated in any
+// order (and by any thread or process) with identical results, so that, for
+// example, a matrix drawn with MakeGaussian( A, CounterRNG(seed) ) does not
+// depend upon the process grid or the number of threads.
+class CounterRNG
+{
+public:
+    explicit CounterRNG( std::uint64_t seed=0 ) EL_NO_EXCEPT;
+
+    std::uint64_t Seed() const EL_NO_EXCEPT { return seed_; }
+
+    // The four random words for the counter (i,j,k)
+    std::array<std::uint32_t,4>
+    Bits( Int i, Int j, unsigned k=0 ) const EL_NO_EXCEPT;
+
+    // A pair of samples from the uniform distribution over [0,1)
+    template<typename Real>
+    void UnitUniformPair
+    ( Int i, Int j, Real& u0, Real& u1, unsigned k=0 ) const;
+
+    // A sample from a uniform PDF over the closed ball about 'center' with
+    // the given radius (see SampleBall)
+    template<typename T>
+    T Ball( Int i, Int j, const T& center, const Base<T>& radius ) const;
+
+    // A sample from a normal distribution (see SampleNormal)
+    template<typename T>
+    T Normal( Int i, Int j, const T& mean, const Base<T>& stddev ) const;
+
+private:
+    std::uint64_t seed_;
+};
+
 // To be used internally by Elemental
 void InitializeRandom( bool deterministic=true );
 void FinalizeRandom();
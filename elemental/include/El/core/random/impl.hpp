@@ -223,6 +223,106 @@ template<typename Real,typename>
 Real SampleBall( const Real& center, const Real& radius )
 { return SampleUniform(center-radius,center+radius); }
 
+// CounterRNG
+// ==========
+
+inline CounterRNG::CounterRNG( std::uint64_t seed ) EL_NO_EXCEPT
+: seed_(seed)
+{ }
+
+inline std::array<std::uint32_t,4>
+CounterRNG::Bits( Int i, Int j, unsigned k ) const EL_NO_EXCEPT
+{
+    const std::uint32_t mult0 = 0xD2511F53, mult1 = 0xCD9E8D57;
+    const std::uint32_t weyl0 = 0x9E3779B9, weyl1 = 0xBB67AE85;
+    const std::uint64_t iWide = i, jWide = j;
+    std::uint32_t ctr[4] =
+      { std::uint32_t(iWide), std::uint32_t(iWide >> 32),
+        std::uint32_t(jWide),
+        std::uint32_t((jWide >> 32) & 0xFFFFFF) | (std::uint32_t(k) << 24) };
+    std::uint32_t key[2] = { std::uint32_t(seed_), std::uint32_t(seed_ >> 32) };
+    for( Int round=0; round<10; ++round )
+    {
+        const std::uint64_t prod0 = std::uint64_t(mult0)*ctr[0];
+        const std::uint64_t prod1 = std::uint64_t(mult1)*ctr[2];
+        const std::uint32_t hi0 = prod0 >> 32, lo0 = std::uint32_t(prod0);
+        const std::uint32_t hi1 = prod1 >> 32, lo1 = std::uint32_t(prod1);
+        ctr[0] = hi1 ^ ctr[1] ^ key[0];
+        ctr[1] = lo1;
+        ctr[2] = hi0 ^ ctr[3] ^ key[1];
+        ctr[3] = lo0;
+        key[0] += weyl0;
+        key[1] += weyl1;
+    }
+    return {{ ctr[0], ctr[1], ctr[2], ctr[3] }};
+}
+
+template<typename Real>
+void CounterRNG::UnitUniformPair
+( Int i, Int j, Real& u0, Real& u1, unsigned k ) const
+{
+    const auto bits = Bits( i, j, k );
+    if( std::is_same<Real,float>::value )
+    {
+        // Use the top 24 bits of a single word for each sample
+        const float scale = 1.f/16777216.f;
+        u0 = Real( float(bits[0] >> 8)*scale );
+        u1 = Real( float(bits[1] >> 8)*scale );
+    }
+    else
+    {
+        // Use the top 53 bits of a pair of words for each sample
+        const double scale = 1./9007199254740992.;
+        const std::uint64_t w0 = (std::uint64_t(bits[0]) << 32) | bits[1];
+        const std::uint64_t w1 = (std::uint64_t(bits[2]) << 32) | bits[3];
+        u0 = Real( double(w0 >> 11)*scale );
+        u1 = Real( double(w1 >> 11)*scale );
+    }
+}
+
+template<typename T>
+T CounterRNG::Ball
+( Int i, Int j, const T& center, const Base<T>& radius ) const
+{
+    typedef Base<T> Real;
+    Real u0, u1;
+    UnitUniformPair( i, j, u0, u1 );
+    T sample = center;
+    if( IsComplex<T>::value )
+    {
+        const Real r = radius*u0;
+        const Real angle = 2*Pi<Real>()*u1;
+        SetRealPart( sample, RealPart(center) + r*Cos(angle) );
+        SetImagPart( sample, ImagPart(center) + r*Sin(angle) );
+    }
+    else
+    {
+        SetRealPart( sample, RealPart(center) + radius*(2*u0-1) );
+    }
+    return sample;
+}
+
+template<typename T>
+T CounterRNG::Normal
+( Int i, Int j, const T& mean, const Base<T>& stddev ) const
+{
+    typedef Base<T> Real;
+    Real stddevAdj = stddev;
+    if( IsComplex<T>::value )
+        stddevAdj /= Sqrt(Real(2));
+
+    // Box-Muller on (0,1] x [0,1)
+    Real u0, u1;
+    UnitUniformPair( i, j, u0, u1 );
+    const Real r = stddevAdj*Sqrt(-2*Log(1-u0));
+    const Real angle = 2*Pi<Real>()*u1;
+    T sample = mean;
+    SetRealPart( sample, RealPart(mean) + r*Cos(angle) );
+    if( IsComplex<T>::value )
+        SetImagPart( sample, ImagPart(mean) + r*Sin(angle) );
+    return sample;
+}
+
 } // namespace El
 
 #endif // ifndef EL_RANDOM_IMPL_HPP
@@ -411,6 +411,18 @@ enum GridOrder
 }
 using namespace GridOrderNS;
 
+// How a process grid is laid out over the nodes (and sockets) of a machine
+namespace GridTopologyNS {
+enum GridTopology
+{
+    GRID_TOPOLOGY_IGNORE,     // keep the ranks' order and the default shape
+    GRID_TOPOLOGY_LOCAL_COLS, // keep each column (MC) communicator on a node
+    GRID_TOPOLOGY_LOCAL_ROWS, // keep each row (MR) communicator on a node
+    GRID_TOPOLOGY_AUTO        // choose among the above
+};
+}
+using namespace GridTopologyNS;
+
 namespace LeftOrRightNS {
 enum LeftOrRight
 {
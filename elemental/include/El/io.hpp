@@ -146,8 +146,26 @@ void Write
 ( const AbstractDistMatrix<T>& A, string basename="DistMatrix",
   FileFormat format=BINARY, string title="" );
 
+// Checkpoint and restore
+// ======================
+// Each process writes its local panel, the global indices of its local rows
+// and columns, and the distribution metadata to its own file, so that the
+// checkpoint proceeds in parallel and can target node-local storage.
+// Restore reads the panels directly back into the local matrices when the
+// grid and distribution are unchanged; otherwise the files are assigned
+// round-robin to the processes and their entries are redistributed.
+template<typename T>
+void Checkpoint
+( const AbstractDistMatrix<T>& A, const string& basename,
+  const string& metadata="" );
+template<typename T>
+void Restore( AbstractDistMatrix<T>& A, const string& basename );
+string ReadCheckpointMetadata( const string& basename, Int fileRank=0 );
+
 } // namespace El
 
+#include <El/io/Checkpoint.hpp>
+
 #ifdef EL_HAVE_QT5
 
 #include <El/io/DisplayWidget.hpp>
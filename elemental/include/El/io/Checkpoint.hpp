@@ -0,0 +1,410 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_IO_CHECKPOINT_HPP
+#define EL_IO_CHECKPOINT_HPP
+
+namespace El {
+
+namespace checkpoint {
+
+// Each process writes a single file, named "<basename>-<rank>.ckpt", which
+// consists of the following fixed-size header, followed by
+//
+//   1) the 'metadataSize' bytes of the user-provided metadata string,
+//   2) the global indices of the 'localHeight' local rows,
+//   3) the global indices of the 'localWidth' local columns, and
+//   4) the local entries, stored column by column with a leading dimension
+//      of 'localHeight'.
+//
+// Storing the global indices explicitly keeps the format independent of the
+// particular element or block distribution and allows for restoring onto a
+// different process grid.
+struct Header
+{
+    char magic[8];
+    Int entrySize;
+    Int height, width;
+    Int colDist, rowDist;
+    Int colAlign, rowAlign, root;
+    Int blockHeight, blockWidth;
+    Int colCut, rowCut;
+    Int gridHeight, gridWidth, gridOrder;
+    Int numFiles, fileRank, redundantRank;
+    Int localHeight, localWidth;
+    Int metadataSize;
+};
+
+inline void SetMagic( Header& header )
+{
+    const char magic[8] = {'E','L','C','K','P','T','0','1'};
+    std::memcpy( header.magic, magic, 8 );
+}
+
+inline bool HasMagic( const Header& header )
+{
+    Header reference;
+    SetMagic( reference );
+    return std::memcmp( header.magic, reference.magic, 8 ) == 0;
+}
+
+inline string FileName( const string& basename, Int fileRank )
+{ return BuildString(basename,"-",fileRank,".ckpt"); }
+
+inline void ReadHeader
+( ifstream& file, const string& filename, Header& header, string& metadata )
+{
+    EL_DEBUG_CSE
+    file.read( reinterpret_cast<char*>(&header), sizeof(Header) );
+    if( !file || !HasMagic(header) )
+        RuntimeError(filename," is not an Elemental checkpoint");
+    metadata.resize( header.metadataSize );
+    if( header.metadataSize > 0 )
+        file.read( &metadata[0], header.metadataSize );
+    if( !file )
+        RuntimeError("Could not read the metadata of ",filename);
+}
+
+// Returns false if the file could not be opened
+template<typename T>
+bool OpenAndReadIndices
+( const string& basename,
+  Int fileRank,
+  ifstream& file,
+  Header& header,
+  vector<Int>& globalRows,
+  vector<Int>& globalCols )
+{
+    EL_DEBUG_CSE
+    const string filename = FileName( basename, fileRank );
+    file.open( filename.c_str(), std::ios::in|std::ios::binary );
+    if( !file.is_open() )
+        return false;
+    string metadata;
+    ReadHeader( file, filename, header, metadata );
+    if( header.entrySize != Int(sizeof(T)) )
+        RuntimeError
+        ("Checkpoint entry size of ",header.entrySize," did not match ",
+         sizeof(T));
+    globalRows.resize( header.localHeight );
+    globalCols.resize( header.localWidth );
+    file.read
+    ( reinterpret_cast<char*>(globalRows.data()),
+      header.localHeight*sizeof(Int) );
+    file.read
+    ( reinterpret_cast<char*>(globalCols.data()),
+      header.localWidth*sizeof(Int) );
+    if( !file )
+        RuntimeError("Could not read the indices of ",filename);
+    return true;
+}
+
+} // namespace checkpoint
+
+template<typename T>
+void Checkpoint
+( const AbstractDistMatrix<T>& A,
+  const string& basename,
+  const string& metadata )
+{
+    EL_DEBUG_CSE
+    static_assert
+    ( std::is_trivially_copyable<T>::value,
+      "Checkpoints are only supported for trivially-copyable datatypes" );
+    const Grid& grid = A.Grid();
+    if( !grid.InGrid() )
+        return;
+    const Int localHeight = A.LocalHeight();
+    const Int localWidth = A.LocalWidth();
+
+    checkpoint::Header header;
+    checkpoint::SetMagic( header );
+    header.entrySize = sizeof(T);
+    header.height = A.Height();
+    header.width = A.Width();
+    header.colDist = A.ColDist();
+    header.rowDist = A.RowDist();
+    header.colAlign = A.ColAlign();
+    header.rowAlign = A.RowAlign();
+    header.root = A.Root();
+    header.blockHeight = A.BlockHeight();
+    header.blockWidth = A.BlockWidth();
+    header.colCut = A.ColCut();
+    header.rowCut = A.RowCut();
+    header.gridHeight = grid.Height();
+    header.gridWidth = grid.Width();
+    header.gridOrder = grid.Order();
+    header.numFiles = grid.Size();
+    header.fileRank = grid.Rank();
+    header.redundantRank = A.RedundantRank();
+    header.localHeight = localHeight;
+    header.localWidth = localWidth;
+    header.metadataSize = metadata.size();
+
+    vector<Int> globalRows(localHeight), globalCols(localWidth);
+    for( Int iLoc=0; iLoc<localHeight; ++iLoc )
+        globalRows[iLoc] = A.GlobalRow(iLoc);
+    for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+        globalCols[jLoc] = A.GlobalCol(jLoc);
+
+    const string filename = checkpoint::FileName( basename, grid.Rank() );
+    bool failedLocal = false;
+    string error;
+    try
+    {
+        ofstream file( filename.c_str(), std::ios::out|std::ios::binary );
+        if( !file.is_open() )
+            RuntimeError("Could not open ",filename);
+        file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+        file.write( metadata.data(), metadata.size() );
+        file.write
+        ( reinterpret_cast<const char*>(globalRows.data()),
+          localHeight*sizeof(Int) );
+        file.write
+        ( reinterpret_cast<const char*>(globalCols.data()),
+          localWidth*sizeof(Int) );
+        const T* ABuf = A.LockedBuffer();
+        const Int ALDim = A.LDim();
+        if( ALDim == localHeight )
+        {
+            file.write
+            ( reinterpret_cast<const char*>(ABuf),
+              localHeight*localWidth*sizeof(T) );
+        }
+        else
+        {
+            for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+                file.write
+                ( reinterpret_cast<const char*>(&ABuf[jLoc*ALDim]),
+                  localHeight*sizeof(T) );
+        }
+        file.close();
+        if( !file )
+            RuntimeError("Could not write ",filename);
+    }
+    catch( std::exception& e )
+    {
+        failedLocal = true;
+        error = e.what();
+    }
+
+    // Do not return until the entire checkpoint is on disk, and report a
+    // failure on any process from every process
+    const int failed =
+      mpi::AllReduce( int(failedLocal), mpi::MAX, grid.Comm() );
+    if( failedLocal )
+        RuntimeError(error);
+    if( failed )
+        RuntimeError("Could not write the checkpoint ",basename);
+}
+
+template<typename T>
+void Restore( AbstractDistMatrix<T>& A, const string& basename )
+{
+    EL_DEBUG_CSE
+    static_assert
+    ( std::is_trivially_copyable<T>::value,
+      "Checkpoints are only supported for trivially-copyable datatypes" );
+    const Grid& grid = A.Grid();
+    if( !grid.InGrid() )
+        return;
+    mpi::Comm comm = grid.Comm();
+    const int commRank = grid.Rank();
+    const int commSize = grid.Size();
+
+    // Broadcast the global description of the checkpoint from the first file
+    // ======================================================================
+    // An error on the first process is reported by every process (rather than
+    // leaving the others waiting within the broadcast)
+    const Int numInfo = 16;
+    Int info[numInfo] = { 0 };
+    string error;
+    if( commRank == 0 )
+    {
+        const string filename = checkpoint::FileName( basename, 0 );
+        try
+        {
+            ifstream file( filename.c_str(), std::ios::in|std::ios::binary );
+            if( !file.is_open() )
+                RuntimeError("Could not open ",filename);
+            checkpoint::Header header;
+            string metadata;
+            checkpoint::ReadHeader( file, filename, header, metadata );
+            const Int headerInfo[numInfo] =
+              { header.height, header.width, header.numFiles,
+                header.colDist, header.rowDist,
+                header.colAlign, header.rowAlign,
+                header.root, header.blockHeight, header.blockWidth,
+                header.colCut, header.rowCut,
+                header.gridHeight, header.gridWidth, header.gridOrder, 1 };
+            std::copy( headerInfo, headerInfo+numInfo, info );
+        }
+        catch( std::exception& e ) { error = e.what(); }
+    }
+    mpi::Broadcast( info, numInfo, 0, comm );
+    if( !info[15] )
+    {
+        if( commRank == 0 )
+            RuntimeError(error);
+        RuntimeError
+        ("Could not read the header of ",checkpoint::FileName(basename,0));
+    }
+    const Int height = info[0];
+    const Int width = info[1];
+    const Int numFiles = info[2];
+
+    // If the process grid and distribution are unchanged, then each process
+    // can read its panel directly into its local matrix
+    // =====================================================================
+    const bool sameLayout =
+      numFiles == commSize &&
+      info[3] == A.ColDist() && info[4] == A.RowDist() &&
+      info[8] == A.BlockHeight() && info[9] == A.BlockWidth() &&
+      info[12] == grid.Height() && info[13] == grid.Width() &&
+      info[14] == grid.Order();
+    if( sameLayout )
+    {
+        DistData data;
+        data.colDist = Dist(info[3]);
+        data.rowDist = Dist(info[4]);
+        data.colAlign = info[5];
+        data.rowAlign = info[6];
+        data.root = info[7];
+        data.blockHeight = info[8];
+        data.blockWidth = info[9];
+        data.colCut = info[10];
+        data.rowCut = info[11];
+        data.grid = &grid;
+        if( !A.RootConstrained() )
+            A.SetRoot( data.root, false );
+        A.AlignWith( data, false, true );
+        A.Resize( height, width );
+
+        ifstream file;
+        checkpoint::Header header;
+        vector<Int> globalRows, globalCols;
+        // A file which cannot be used here is reported by the fallback below
+        bool opened = false;
+        try
+        {
+            opened = checkpoint::OpenAndReadIndices<T>
+            ( basename, commRank, file, header, globalRows, globalCols );
+        }
+        catch( std::exception& ) { }
+        const Int localHeight = A.LocalHeight();
+        const Int localWidth = A.LocalWidth();
+        int matches = opened &&
+          header.localHeight == localHeight && header.localWidth == localWidth;
+        for( Int iLoc=0; iLoc<localHeight && matches; ++iLoc )
+            matches = ( globalRows[iLoc] == A.GlobalRow(iLoc) );
+        for( Int jLoc=0; jLoc<localWidth && matches; ++jLoc )
+            matches = ( globalCols[jLoc] == A.GlobalCol(jLoc) );
+        matches = mpi::AllReduce( matches, mpi::MIN, comm );
+        if( matches )
+        {
+            for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+                file.read
+                ( reinterpret_cast<char*>(A.Buffer(0,jLoc)),
+                  localHeight*sizeof(T) );
+            const bool readLocal = bool(file);
+            const int readAll =
+              mpi::AllReduce( int(readLocal), mpi::MIN, comm );
+            if( !readLocal )
+                RuntimeError
+                ("Could not read ",checkpoint::FileName(basename,commRank));
+            if( !readAll )
+                RuntimeError("Could not read the checkpoint ",basename);
+            return;
+        }
+    }
+
+    // Otherwise, the files are distributed round-robin over the processes
+    // and their entries are routed to their new owners one round at a time
+    // (this requires that each file be readable by its assigned process)
+    // ======================================================================
+    Zeros( A, height, width );
+    const Int numRounds = (numFiles+commSize-1) / commSize;
+    vector<T> colBuf;
+    for( Int round=0; round<numRounds; ++round )
+    {
+        const Int fileRank = round*commSize + commRank;
+        // Failures are agreed upon before the (collective) exchange so that
+        // every process throws rather than waiting on the failed ones
+        bool failedLocal = false;
+        string error;
+        if( fileRank < numFiles )
+        {
+            try
+            {
+                ifstream file;
+                checkpoint::Header header;
+                vector<Int> globalRows, globalCols;
+                if( !checkpoint::OpenAndReadIndices<T>
+                    ( basename, fileRank, file, header,
+                      globalRows, globalCols ) )
+                    RuntimeError
+                    ("Could not open ",
+                     checkpoint::FileName(basename,fileRank));
+                // Redundant copies of the same entries would otherwise be
+                // summed
+                if( header.redundantRank == 0 )
+                {
+                    const Int localHeight = header.localHeight;
+                    const Int localWidth = header.localWidth;
+                    A.Reserve( localHeight*localWidth );
+                    colBuf.resize( localHeight );
+                    for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+                    {
+                        file.read
+                        ( reinterpret_cast<char*>(colBuf.data()),
+                          localHeight*sizeof(T) );
+                        if( !file )
+                            RuntimeError
+                            ("Could not read ",
+                             checkpoint::FileName(basename,fileRank));
+                        for( Int iLoc=0; iLoc<localHeight; ++iLoc )
+                            A.QueueUpdate
+                            ( globalRows[iLoc], globalCols[jLoc],
+                              colBuf[iLoc] );
+                    }
+                }
+            }
+            catch( std::exception& e )
+            {
+                failedLocal = true;
+                error = e.what();
+            }
+        }
+        const int failed =
+          mpi::AllReduce( int(failedLocal), mpi::MAX, comm );
+        if( failed )
+        {
+            if( failedLocal )
+                RuntimeError(error);
+            RuntimeError("Could not read the checkpoint ",basename);
+        }
+        A.ProcessQueues();
+    }
+}
+
+inline string ReadCheckpointMetadata( const string& basename, Int fileRank )
+{
+    EL_DEBUG_CSE
+    const string filename = checkpoint::FileName( basename, fileRank );
+    ifstream file( filename.c_str(), std::ios::in|std::ios::binary );
+    if( !file.is_open() )
+        RuntimeError("Could not open ",filename);
+    checkpoint::Header header;
+    string metadata;
+    checkpoint::ReadHeader( file, filename, header, metadata );
+    return metadata;
+}
+
+} // namespace El
+
+#endif // ifndef EL_IO_CHECKPOINT_HPP
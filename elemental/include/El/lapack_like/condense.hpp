@@ -141,6 +141,73 @@ void ApplyQ
   const AbstractDistMatrix<Field>& householderScalars,
         AbstractDistMatrix<Field>& B );
 
+// Two-stage reduction to tridiagonal form
+// ---------------------------------------
+// The Hermitian matrix is first reduced to a band matrix using Level 3 BLAS
+// and the band is then reduced to a (redundantly stored) tridiagonal matrix
+// by pipelined bulge chasing, A = (Q1 Q2) T (Q1 Q2)'. Q1 is implicitly
+// stored within A and (householderScalars,signature), and Q2 within a
+// BulgeChaseReflectors structure (if 'storeReflectors' is true).
+
+template<typename Field>
+struct BulgeChaseReflectors
+{
+    Int bandwidth=0;
+    // The k'th locally stored reflector acts upon rows
+    // [offsets[k],offsets[k]+lengths[k])
+    vector<Int> offsets, lengths;
+    // Column k holds [1; v_k]
+    Matrix<Field> V;
+    vector<Field> householderScalars;
+
+    // Process q of 'comm' owns the band columns
+    // [columnOffsets[q],columnOffsets[q+1]) and only stores the reflectors
+    // of the bulge-chasing steps whose windows begin within them
+    vector<Int> columnOffsets;
+    mpi::Comm comm=mpi::COMM_SELF;
+};
+
+template<typename Field>
+void TwoStage
+( UpperOrLower uplo,
+  Matrix<Field>& A,
+  Int bandwidth,
+  Matrix<Field>& householderScalars,
+  Matrix<Base<Field>>& signature,
+  Matrix<Base<Field>>& d,
+  Matrix<Field>& dSub,
+  BulgeChaseReflectors<Field>& reflectors,
+  bool storeReflectors=true );
+template<typename Field>
+void TwoStage
+( UpperOrLower uplo,
+  AbstractDistMatrix<Field>& A,
+  Int bandwidth,
+  AbstractDistMatrix<Field>& householderScalars,
+  AbstractDistMatrix<Base<Field>>& signature,
+  Matrix<Base<Field>>& d,
+  Matrix<Field>& dSub,
+  BulgeChaseReflectors<Field>& reflectors,
+  bool storeReflectors=true );
+
+// Overwrite B with (Q1 Q2) B
+template<typename Field>
+void ApplyTwoStageQ
+( const Matrix<Field>& A,
+  Int bandwidth,
+  const Matrix<Field>& householderScalars,
+  const Matrix<Base<Field>>& signature,
+  const BulgeChaseReflectors<Field>& reflectors,
+        Matrix<Field>& B );
+template<typename Field>
+void ApplyTwoStageQ
+( const AbstractDistMatrix<Field>& A,
+  Int bandwidth,
+  const AbstractDistMatrix<Field>& householderScalars,
+  const AbstractDistMatrix<Base<Field>>& signature,
+  const BulgeChaseReflectors<Field>& reflectors,
+        AbstractDistMatrix<Field>& B );
+
 } // namespace herm_tridiag
 
 // Hessenberg
@@ -190,4 +257,6 @@ void FormQ
 
 } // namespace El
 
+#include <El/lapack_like/condense/HermitianTridiagTwoStage.hpp>
+
 #endif // ifndef EL_CONDENSE_HPP
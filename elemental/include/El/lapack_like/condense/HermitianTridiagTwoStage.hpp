@@ -0,0 +1,763 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_CONDENSE_HERMITIAN_TRIDIAG_TWO_STAGE_HPP
+#define EL_CONDENSE_HERMITIAN_TRIDIAG_TWO_STAGE_HPP
+
+namespace El {
+namespace herm_tridiag {
+
+// Full to band
+// ============
+// For each panel of 'bandwidth' columns, the QR factorization of the portion
+// below the band is computed and the trailing matrix is overwritten with
+// Q' A22 Q. As in LAPACK's block reduction to tridiagonal form, Q (without
+// its signature) is written in the form I - V M V', with V the unit
+// lower-trapezoidal reflectors, so that
+//
+//   Q' A22 Q = A22 - V W' - W V',  where W = Y - V (M' V' Y) / 2, Y = A22 V M,
+//
+// which only requires a Hemm and a Her2k upon the lower triangle of A22
+// rather than applying Q from both sides of the full trailing matrix. On
+// exit, the lower band of A (that is, the entries A(i,j) with
+// 0 <= i-j <= bandwidth) contains the Hermitian band matrix and the
+// reflectors of each panel are stored below the band; the strictly upper
+// triangle of A is not kept up to date.
+
+inline Int FullToBandNumScalars( Int n, Int bandwidth )
+{
+    Int numScalars = 0;
+    for( Int k=0; k+bandwidth<n-1; k+=bandwidth )
+        numScalars += Min( n-k-bandwidth, bandwidth );
+    return numScalars;
+}
+
+// Overwrite the lower triangle of A22 with that of Q' A22 Q, where Q is the
+// unitary matrix from the QR factorization of A21
+template<typename Field>
+void PanelUpdate
+( const Matrix<Field>& A21,
+  const Matrix<Field>& panelScalars,
+  const Matrix<Base<Field>>& panelSignature,
+        Matrix<Field>& A22 )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int m = A21.Height();
+    const Int r = panelScalars.Height();
+
+    Matrix<Field> V;
+    V = A21( ALL, IR(0,r) );
+    MakeTrapezoidal( LOWER, V );
+    FillDiagonal( V, Field(1) );
+    auto V1 = V( IR(0,r), ALL );
+
+    // The product of the reflectors maps the first r unit vectors to
+    // E - V M V1', which determines M
+    Matrix<Field> E, M;
+    Matrix<Real> ones;
+    Identity( E, m, r );
+    Ones( ones, r, 1 );
+    qr::ApplyQ( LEFT, NORMAL, A21, panelScalars, ones, E );
+    M = E( IR(0,r), ALL );
+    Scale( Field(-1), M );
+    ShiftDiagonal( M, Field(1) );
+    Trsm( LEFT, LOWER, NORMAL, UNIT, Field(1), V1, M );
+    Trsm( RIGHT, LOWER, ADJOINT, UNIT, Field(1), V1, M );
+
+    Matrix<Field> AV, Y, Z, X;
+    Zeros( AV, m, r );
+    Hemm( LEFT, LOWER, Field(1), A22, V, Field(0), AV );
+    Gemm( NORMAL, NORMAL, Field(1), AV, M, Y );
+    Gemm( ADJOINT, NORMAL, Field(1), V, Y, Z );
+    Gemm( ADJOINT, NORMAL, Field(1), M, Z, X );
+    Gemm( NORMAL, NORMAL, Field(-1)/Field(2), V, X, Field(1), Y );
+    Her2k( LOWER, NORMAL, Field(-1), V, Y, Real(1), A22 );
+
+    // Apply the signature from both sides
+    auto A22T = A22( IR(0,r), ALL );
+    auto A22L = A22( ALL, IR(0,r) );
+    DiagonalScale( LEFT, NORMAL, panelSignature, A22T );
+    DiagonalScale( RIGHT, NORMAL, panelSignature, A22L );
+}
+
+template<typename Field>
+void PanelUpdate
+( const DistMatrix<Field>& A21,
+  const DistMatrix<Field,STAR,STAR>& panelScalars,
+  const DistMatrix<Base<Field>,STAR,STAR>& panelSignature,
+        DistMatrix<Field>& A22 )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = A21.Grid();
+    const Int m = A21.Height();
+    const Int r = panelScalars.Height();
+
+    DistMatrix<Field> V(g);
+    V = A21( ALL, IR(0,r) );
+    MakeTrapezoidal( LOWER, V );
+    FillDiagonal( V, Field(1) );
+
+    // The product of the reflectors maps the first r unit vectors to
+    // E - V M V1', which determines M
+    DistMatrix<Field> E(g);
+    DistMatrix<Real,STAR,STAR> ones(g);
+    Identity( E, m, r );
+    Ones( ones, r, 1 );
+    qr::ApplyQ( LEFT, NORMAL, A21, panelScalars, ones, E );
+    DistMatrix<Field,STAR,STAR> M(g), V1(g);
+    M = E( IR(0,r), ALL );
+    V1 = V( IR(0,r), ALL );
+    Scale( Field(-1), M );
+    ShiftDiagonal( M, Field(1) );
+    Trsm
+    ( LEFT, LOWER, NORMAL, UNIT, Field(1), V1.LockedMatrix(), M.Matrix() );
+    Trsm
+    ( RIGHT, LOWER, ADJOINT, UNIT, Field(1), V1.LockedMatrix(), M.Matrix() );
+
+    DistMatrix<Field> AV(g), Y(g), X(g);
+    Zeros( AV, m, r );
+    Hemm( LEFT, LOWER, Field(1), A22, V, Field(0), AV );
+    Gemm( NORMAL, NORMAL, Field(1), AV, M, Y );
+    Gemm( ADJOINT, NORMAL, Field(1), V, Y, X );
+    DistMatrix<Field,STAR,STAR> X_STAR_STAR( X ), MX(g);
+    Zeros( MX, r, r );
+    Gemm
+    ( ADJOINT, NORMAL,
+      Field(1), M.LockedMatrix(), X_STAR_STAR.LockedMatrix(),
+      Field(0), MX.Matrix() );
+    Gemm( NORMAL, NORMAL, Field(-1)/Field(2), V, MX, Field(1), Y );
+    Her2k( LOWER, NORMAL, Field(-1), V, Y, Real(1), A22 );
+
+    // Apply the signature from both sides
+    auto A22T = A22( IR(0,r), ALL );
+    auto A22L = A22( ALL, IR(0,r) );
+    DiagonalScale( LEFT, NORMAL, panelSignature, A22T );
+    DiagonalScale( RIGHT, NORMAL, panelSignature, A22L );
+}
+
+template<typename Field>
+void FullToBand
+( UpperOrLower uplo,
+  Matrix<Field>& A,
+  Int bandwidth,
+  Matrix<Field>& householderScalars,
+  Matrix<Base<Field>>& signature )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    if( A.Width() != n )
+        LogicError("A must be square");
+    if( bandwidth < 1 )
+        LogicError("The bandwidth must be positive");
+    MakeHermitian( uplo, A );
+
+    const Int numScalars = FullToBandNumScalars( n, bandwidth );
+    Zeros( householderScalars, numScalars, 1 );
+    Zeros( signature, numScalars, 1 );
+
+    Matrix<Field> panelScalars;
+    Matrix<Base<Field>> panelSignature;
+    Int offset = 0;
+    for( Int k=0; k+bandwidth<n-1; k+=bandwidth )
+    {
+        const Range<Int> ind1( k, k+bandwidth ), ind2( k+bandwidth, n );
+        auto A21 = A( ind2, ind1 );
+        auto A22 = A( ind2, ind2 );
+
+        QR( A21, panelScalars, panelSignature );
+        PanelUpdate( A21, panelScalars, panelSignature, A22 );
+
+        const Range<Int> scalarInd( offset, offset+panelScalars.Height() );
+        auto scalars = householderScalars( scalarInd, ALL );
+        auto sig = signature( scalarInd, ALL );
+        scalars = panelScalars;
+        sig = panelSignature;
+        offset += panelScalars.Height();
+    }
+}
+
+template<typename Field>
+void FullToBand
+( UpperOrLower uplo,
+  AbstractDistMatrix<Field>& APre,
+  Int bandwidth,
+  AbstractDistMatrix<Field>& householderScalarsPre,
+  AbstractDistMatrix<Base<Field>>& signaturePre )
+{
+    EL_DEBUG_CSE
+    const Int n = APre.Height();
+    if( APre.Width() != n )
+        LogicError("A must be square");
+    if( bandwidth < 1 )
+        LogicError("The bandwidth must be positive");
+
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> AProx( APre );
+    DistMatrixWriteProxy<Field,Field,STAR,STAR>
+      householderScalarsProx( householderScalarsPre );
+    DistMatrixWriteProxy<Base<Field>,Base<Field>,STAR,STAR>
+      signatureProx( signaturePre );
+    auto& A = AProx.Get();
+    auto& householderScalars = householderScalarsProx.Get();
+    auto& signature = signatureProx.Get();
+    const Grid& g = A.Grid();
+    MakeHermitian( uplo, A );
+
+    const Int numScalars = FullToBandNumScalars( n, bandwidth );
+    Zeros( householderScalars, numScalars, 1 );
+    Zeros( signature, numScalars, 1 );
+
+    DistMatrix<Field,STAR,STAR> panelScalars(g);
+    DistMatrix<Base<Field>,STAR,STAR> panelSignature(g);
+    Int offset = 0;
+    for( Int k=0; k+bandwidth<n-1; k+=bandwidth )
+    {
+        const Range<Int> ind1( k, k+bandwidth ), ind2( k+bandwidth, n );
+        auto A21 = A( ind2, ind1 );
+        auto A22 = A( ind2, ind2 );
+
+        QR( A21, panelScalars, panelSignature );
+        PanelUpdate( A21, panelScalars, panelSignature, A22 );
+
+        const Range<Int> scalarInd( offset, offset+panelScalars.Height() );
+        auto scalars = householderScalars( scalarInd, ALL );
+        auto sig = signature( scalarInd, ALL );
+        scalars = panelScalars;
+        sig = panelSignature;
+        offset += panelScalars.Height();
+    }
+}
+
+// Overwrite B with Q1 B, where Q1 is the unitary matrix from FullToBand
+template<typename Field>
+void ApplyBandQ
+( const Matrix<Field>& A,
+  Int bandwidth,
+  const Matrix<Field>& householderScalars,
+  const Matrix<Base<Field>>& signature,
+        Matrix<Field>& B )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    Int offset = householderScalars.Height();
+    const Int lastPanel = ((n-2)/bandwidth)*bandwidth;
+    for( Int k=lastPanel; k>=0; k-=bandwidth )
+    {
+        if( k+bandwidth >= n-1 )
+            continue;
+        const Range<Int> ind1( k, k+bandwidth ), ind2( k+bandwidth, n );
+        const Int numPanelScalars = Min( n-k-bandwidth, bandwidth );
+        offset -= numPanelScalars;
+        const Range<Int> scalarInd( offset, offset+numPanelScalars );
+
+        auto A21 = A( ind2, ind1 );
+        auto B2 = B( ind2, ALL );
+        qr::ApplyQ
+        ( LEFT, NORMAL, A21,
+          householderScalars(scalarInd,ALL), signature(scalarInd,ALL), B2 );
+    }
+}
+
+template<typename Field>
+void ApplyBandQ
+( const AbstractDistMatrix<Field>& APre,
+  Int bandwidth,
+  const AbstractDistMatrix<Field>& householderScalarsPre,
+  const AbstractDistMatrix<Base<Field>>& signaturePre,
+        AbstractDistMatrix<Field>& BPre )
+{
+    EL_DEBUG_CSE
+    DistMatrixReadProxy<Field,Field,MC,MR> AProx( APre );
+    DistMatrixReadProxy<Field,Field,STAR,STAR>
+      householderScalarsProx( householderScalarsPre );
+    DistMatrixReadProxy<Base<Field>,Base<Field>,STAR,STAR>
+      signatureProx( signaturePre );
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> BProx( BPre );
+    auto& A = AProx.GetLocked();
+    auto& householderScalars = householderScalarsProx.GetLocked();
+    auto& signature = signatureProx.GetLocked();
+    auto& B = BProx.Get();
+
+    const Int n = A.Height();
+    Int offset = householderScalars.Height();
+    const Int lastPanel = ((n-2)/bandwidth)*bandwidth;
+    for( Int k=lastPanel; k>=0; k-=bandwidth )
+    {
+        if( k+bandwidth >= n-1 )
+            continue;
+        const Range<Int> ind1( k, k+bandwidth ), ind2( k+bandwidth, n );
+        const Int numPanelScalars = Min( n-k-bandwidth, bandwidth );
+        offset -= numPanelScalars;
+        const Range<Int> scalarInd( offset, offset+numPanelScalars );
+
+        auto A21 = A( ind2, ind1 );
+        auto B2 = B( ind2, ALL );
+        qr::ApplyQ
+        ( LEFT, NORMAL, A21,
+          householderScalars(scalarInd,ALL), signature(scalarInd,ALL), B2 );
+    }
+}
+
+// Extracting the band
+// ===================
+// The lower band is returned in a (2 bandwidth) x n matrix W with
+// W(i-j,j) = A(i,j), where the extra rows hold the bulges created during the
+// reduction to tridiagonal form.
+
+template<typename Field>
+void GetBand( const Matrix<Field>& A, Int bandwidth, Matrix<Field>& W )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    Zeros( W, 2*bandwidth, n );
+    for( Int j=0; j<n; ++j )
+        for( Int i=j; i<Min(j+bandwidth+1,n); ++i )
+            W(i-j,j) = A(i,j);
+}
+
+// Every process receives a copy of the band
+template<typename Field>
+void GetBand
+( const AbstractDistMatrix<Field>& A, Int bandwidth, Matrix<Field>& W )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    const Int localWidth = A.LocalWidth();
+    Matrix<Field> band;
+    Zeros( band, bandwidth+1, n );
+    if( A.RedundantRank() == 0 )
+    {
+        for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+        {
+            const Int j = A.GlobalCol(jLoc);
+            const Int iLocBeg = A.LocalRowOffset( j );
+            const Int iLocEnd = A.LocalRowOffset( Min(j+bandwidth+1,n) );
+            for( Int iLoc=iLocBeg; iLoc<iLocEnd; ++iLoc )
+                band(A.GlobalRow(iLoc)-j,j) = A.GetLocal(iLoc,jLoc);
+        }
+    }
+    mpi::AllReduce( band.Buffer(), (bandwidth+1)*n, A.Grid().Comm() );
+
+    Zeros( W, 2*bandwidth, n );
+    auto WBand = W( IR(0,bandwidth+1), ALL );
+    WBand = band;
+}
+
+// Band to tridiagonal
+// ===================
+// The band is reduced to tridiagonal form by a sequence of sweeps, the j'th
+// of which annihilates the entries of column j below the subdiagonal with a
+// reflector of length at most 'bandwidth' and then chases the resulting
+// bulge down the band one block of 'bandwidth' rows at a time, cf.
+//
+//   Bruno Lang, "A parallel algorithm for reducing symmetric banded matrices
+//   to tridiagonal form", SIAM J. Sci. Comput., 14(6), 1993.
+//
+// Each step only touches a window of at most three blocks, so the work and
+// storage are O(n^2 bandwidth) and O(n bandwidth), respectively.
+//
+// As in Lang's algorithm, the columns of the band are partitioned into
+// contiguous parts, one per process of the communicator (each at least three
+// blocks wide, so that a window overlaps at most two parts), and each step is
+// performed by the owner of the first column of its window after fetching
+// the remainder of the window from its right neighbor. Since process q only
+// needs to have finished sweep j-1 before serving the windows of sweep j
+// that overlap its columns, the sweeps are pipelined: while process q works
+// on sweep j, process q+1 works on sweep j-1, and so on. The parts are sized
+// so that each contains roughly the same number of steps.
+//
+// If requested, the reflectors H_k = I - tau_k [1; v_k] [1; v_k]' are stored
+// (see BulgeChaseReflectors) by the processes which computed them, so that
+// the unitary matrix Q2 such that B = Q2 T Q2' is
+//
+//   Q2 = H_0' H_1' ... H_{m-1}',
+//
+// with the reflectors ordered by sweep and then by step.
+
+// The first column owned by each process (and the number of columns)
+inline vector<Int> BandColumnOffsets( Int n, Int bandwidth, int commSize )
+{
+    // The number of steps covering column c grows linearly with c, so the
+    // k'th of q parts should end at roughly n sqrt((k+1)/q)
+    const Int minWidth = 3*bandwidth;
+    const Int numParts = Max( Min( Int(commSize), n/minWidth ), Int(1) );
+    vector<Int> columnOffsets( numParts+1 );
+    columnOffsets[0] = 0;
+    for( Int k=1; k<numParts; ++k )
+    {
+        const Int target = Int(n*Sqrt(double(k)/numParts));
+        columnOffsets[k] =
+          Min( Max( target, columnOffsets[k-1]+minWidth ),
+               n-(numParts-k)*minWidth );
+    }
+    columnOffsets[numParts] = n;
+    return columnOffsets;
+}
+
+// Annihilate W(r0+1:r1,col) (with the Hermitian band stored in W as in
+// GetBand) by applying H = I - tau u u' from both sides of the window
+// [col,windowEnd) and return tau
+template<typename Field>
+Field BulgeChaseStep
+( Matrix<Field>& W, Int col, Int r0, Int r1, Int windowEnd,
+  Matrix<Field>& u, Matrix<Field>& S, Matrix<Field>& z )
+{
+    const Int storedDiags = W.Height();
+    auto get = [&]( Int i, Int j )
+      {
+          if( i >= j )
+              return i-j < storedDiags ? W(i-j,j) : Field(0);
+          else
+              return j-i < storedDiags ? Conj(W(j-i,i)) : Field(0);
+      };
+
+    // Copy the window [col,windowEnd) into a full Hermitian matrix
+    const Int windowSize = windowEnd - col;
+    S.Resize( windowSize, windowSize );
+    for( Int jw=0; jw<windowSize; ++jw )
+        for( Int iw=0; iw<windowSize; ++iw )
+            S(iw,jw) = get( col+iw, col+jw );
+
+    // Annihilate S(r0+1:r1,col)
+    const Range<Int> rowInd( r0-col, r1-col+1 );
+    const Int length = r1 - r0 + 1;
+    Field& chi = S(r0-col,0);
+    auto x = S( IR(r0-col+1,r1-col+1), IR(0) );
+    const Field tau = LeftReflector( chi, x );
+    const Field beta = chi;
+    u.Resize( length, 1 );
+    u(0) = Field(1);
+    for( Int i=1; i<length; ++i )
+        u(i) = x(i-1);
+
+    // S(rowInd,:) := H S(rowInd,:)
+    auto SRows = S( rowInd, ALL );
+    Gemv( ADJOINT, Field(1), SRows, u, z );
+    Ger( -tau, u, z, SRows );
+    // S(:,rowInd) := S(:,rowInd) H'
+    auto SCols = S( ALL, rowInd );
+    Gemv( NORMAL, Field(1), SCols, u, z );
+    Ger( -Conj(tau), z, u, SCols );
+    S(r0-col,0) = beta;
+    for( Int i=r0+1; i<=r1; ++i )
+        S(i-col,0) = Field(0);
+
+    // Store the lower part of the window back into the band
+    for( Int jw=0; jw<windowSize; ++jw )
+        for( Int iw=jw; iw<Min(jw+storedDiags,windowSize); ++iw )
+            W(iw-jw,col+jw) = S(iw,jw);
+
+    return tau;
+}
+
+// Every process should pass in the full band and receives the full
+// tridiagonal matrix, but W is only kept up to date within the columns owned
+// by each process
+template<typename Field>
+void BandToTridiag
+( Matrix<Field>& W,
+  Matrix<Base<Field>>& d,
+  Matrix<Field>& dSub,
+  BulgeChaseReflectors<Field>& reflectors,
+  mpi::Comm comm,
+  bool storeReflectors=true )
+{
+    EL_DEBUG_CSE
+    const Int n = W.Width();
+    const Int storedDiags = W.Height();
+    const Int bandwidth = storedDiags/2;
+    if( bandwidth < 1 )
+        LogicError("The bandwidth must be positive");
+    if( W.LDim() != storedDiags )
+        LogicError("The columns of the band must be contiguous");
+    const int commRank = mpi::Rank( comm );
+
+    reflectors.bandwidth = bandwidth;
+    reflectors.comm = comm;
+    reflectors.columnOffsets =
+      BandColumnOffsets( n, bandwidth, mpi::Size(comm) );
+    reflectors.offsets.clear();
+    reflectors.lengths.clear();
+    reflectors.householderScalars.clear();
+    const auto& columnOffsets = reflectors.columnOffsets;
+    const Int numParts = columnOffsets.size()-1;
+    const bool owner = commRank < numParts;
+    const Int colBeg = owner ? columnOffsets[commRank] : 0;
+    const Int colEnd = owner ? columnOffsets[commRank+1] : 0;
+
+    if( storeReflectors )
+    {
+        Int numLocalReflectors = 0;
+        for( Int j=0; j<Min(n-2,colEnd); ++j )
+        {
+            Int col = j;
+            for( Int r0=j+1; Min(r0+bandwidth-1,n-1)>r0; r0+=bandwidth )
+            {
+                if( col >= colBeg && col < colEnd )
+                    ++numLocalReflectors;
+                col = r0;
+            }
+        }
+        Zeros( reflectors.V, bandwidth, numLocalReflectors );
+        reflectors.offsets.reserve( numLocalReflectors );
+        reflectors.lengths.reserve( numLocalReflectors );
+        reflectors.householderScalars.reserve( numLocalReflectors );
+    }
+
+    Matrix<Field> u, S, z;
+    for( Int j=0; j<Min(n-2,colEnd); ++j )
+    {
+        Int col = j;
+        Int r0 = j+1;
+        Int r1 = Min(j+bandwidth,n-1);
+        while( r1 > r0 && col < colEnd )
+        {
+            const Int windowEnd = Min(r1+bandwidth,n-1)+1;
+            if( col < colBeg )
+            {
+                // Serve a window of our left neighbor which overlaps our
+                // columns
+                if( col >= columnOffsets[commRank-1] && windowEnd > colBeg )
+                {
+                    const int count = (windowEnd-colBeg)*storedDiags;
+                    mpi::Send( W.Buffer(0,colBeg), count, commRank-1, comm );
+                    mpi::Recv( W.Buffer(0,colBeg), count, commRank-1, comm );
+                }
+            }
+            else
+            {
+                const bool straddles = windowEnd > colEnd;
+                const int count = (windowEnd-colEnd)*storedDiags;
+                if( straddles )
+                    mpi::Recv( W.Buffer(0,colEnd), count, commRank+1, comm );
+                const Field tau =
+                  BulgeChaseStep( W, col, r0, r1, windowEnd, u, S, z );
+                if( straddles )
+                    mpi::Send( W.Buffer(0,colEnd), count, commRank+1, comm );
+
+                if( storeReflectors )
+                {
+                    const Int k = reflectors.offsets.size();
+                    auto vk = reflectors.V( IR(0,r1-r0+1), IR(k) );
+                    vk = u;
+                    reflectors.offsets.push_back( r0 );
+                    reflectors.lengths.push_back( r1-r0+1 );
+                    reflectors.householderScalars.push_back( tau );
+                }
+            }
+
+            col = r0;
+            r0 = r1+1;
+            r1 = Min(r0+bandwidth-1,n-1);
+        }
+    }
+
+    Zeros( d, n, 1 );
+    Zeros( dSub, Max(n-1,Int(0)), 1 );
+    for( Int i=colBeg; i<colEnd; ++i )
+    {
+        d(i) = RealPart(W(0,i));
+        if( i < n-1 )
+            dSub(i) = W(1,i);
+    }
+    mpi::AllReduce( d.Buffer(), n, comm );
+    mpi::AllReduce( dSub.Buffer(), Max(n-1,Int(0)), comm );
+}
+
+// Overwrite B with Q2 B, where Q2 is the unitary matrix from BandToTridiag
+template<typename Field>
+void ApplyBulgeChaseQ
+( const BulgeChaseReflectors<Field>& reflectors, Matrix<Field>& B )
+{
+    EL_DEBUG_CSE
+    if( reflectors.columnOffsets.size() > 2 )
+        LogicError("The reflectors are spread over several processes");
+    Matrix<Field> z;
+    const Int numReflectors = reflectors.offsets.size();
+    for( Int k=numReflectors-1; k>=0; --k )
+    {
+        const Int offset = reflectors.offsets[k];
+        const Int length = reflectors.lengths[k];
+        const Field tau = reflectors.householderScalars[k];
+        auto u = reflectors.V( IR(0,length), IR(k) );
+        auto BRows = B( IR(offset,offset+length), ALL );
+        // BRows := H_k' BRows
+        Gemv( ADJOINT, Field(1), BRows, u, z );
+        Ger( -Conj(tau), u, z, BRows );
+    }
+}
+
+// The reflectors are gathered onto every process a tile of 'bandwidth'
+// sweeps at a time (of at most n bandwidth entries), starting from the last,
+// and each process applies them to its own columns of B, which must be
+// distributed over the grid that the reduction was performed over
+template<typename Field>
+void ApplyBulgeChaseQ
+( const BulgeChaseReflectors<Field>& reflectors,
+  AbstractDistMatrix<Field>& BPre )
+{
+    EL_DEBUG_CSE
+    DistMatrixReadWriteProxy<Field,Field,STAR,VR> BProx( BPre );
+    auto& B = BProx.Get();
+    auto& BLoc = B.Matrix();
+    const Int n = B.Height();
+    const Int bandwidth = reflectors.bandwidth;
+    const auto& columnOffsets = reflectors.columnOffsets;
+    if( columnOffsets.empty() || columnOffsets.back() != n )
+        LogicError("The reflectors do not match the height of B");
+    mpi::Comm comm = reflectors.comm;
+    const int commRank = mpi::Rank( comm );
+    const Int numParts = columnOffsets.size()-1;
+    const bool owner = commRank < numParts;
+    const Int colBeg = owner ? columnOffsets[commRank] : 0;
+    const Int colEnd = owner ? columnOffsets[commRank+1] : 0;
+
+    vector<Int> offsets, lengths;
+    vector<bool> local;
+    vector<Field> householderScalars;
+    Matrix<Field> V, z;
+    Int localEnd = reflectors.offsets.size();
+    const Int numSweeps = Max(n-2,Int(0));
+    const Int numTiles = (numSweeps+bandwidth-1)/bandwidth;
+    for( Int tile=numTiles-1; tile>=0; --tile )
+    {
+        const Int sweepBeg = tile*bandwidth;
+        const Int sweepEnd = Min(sweepBeg+bandwidth,numSweeps);
+
+        offsets.clear();
+        lengths.clear();
+        local.clear();
+        for( Int j=sweepBeg; j<sweepEnd; ++j )
+        {
+            Int col = j;
+            Int r0 = j+1;
+            Int r1 = Min(j+bandwidth,n-1);
+            while( r1 > r0 )
+            {
+                offsets.push_back( r0 );
+                lengths.push_back( r1-r0+1 );
+                local.push_back( col >= colBeg && col < colEnd );
+                col = r0;
+                r0 = r1+1;
+                r1 = Min(r0+bandwidth-1,n-1);
+            }
+        }
+        const Int numTileReflectors = offsets.size();
+        if( numTileReflectors == 0 )
+            continue;
+
+        // Gather the reflectors of this tile
+        const Int numLocal = std::count( local.begin(), local.end(), true );
+        const Int localBeg = localEnd - numLocal;
+        Zeros( V, bandwidth, numTileReflectors );
+        householderScalars.assign( numTileReflectors, Field(0) );
+        for( Int k=0, kLoc=localBeg; k<numTileReflectors; ++k )
+        {
+            if( !local[k] )
+                continue;
+            auto vk = V( ALL, IR(k) );
+            vk = reflectors.V( ALL, IR(kLoc) );
+            householderScalars[k] = reflectors.householderScalars[kLoc];
+            ++kLoc;
+        }
+        localEnd = localBeg;
+        mpi::AllReduce( V.Buffer(), bandwidth*numTileReflectors, comm );
+        mpi::AllReduce( householderScalars.data(), numTileReflectors, comm );
+
+        for( Int k=numTileReflectors-1; k>=0; --k )
+        {
+            const Int offset = offsets[k];
+            const Int length = lengths[k];
+            const Field tau = householderScalars[k];
+            auto u = V( IR(0,length), IR(k) );
+            auto BRows = BLoc( IR(offset,offset+length), ALL );
+            // BRows := H_k' BRows
+            Gemv( ADJOINT, Field(1), BRows, u, z );
+            Ger( -Conj(tau), u, z, BRows );
+        }
+    }
+}
+
+// Two-stage reduction
+// ===================
+// A = (Q1 Q2) T (Q1 Q2)', where Q1 is implicitly stored within A and
+// (householderScalars,signature) and Q2 within 'reflectors'. The tridiagonal
+// matrix T is returned via its diagonal and subdiagonal on every process.
+
+template<typename Field>
+void TwoStage
+( UpperOrLower uplo,
+  Matrix<Field>& A,
+  Int bandwidth,
+  Matrix<Field>& householderScalars,
+  Matrix<Base<Field>>& signature,
+  Matrix<Base<Field>>& d,
+  Matrix<Field>& dSub,
+  BulgeChaseReflectors<Field>& reflectors,
+  bool storeReflectors )
+{
+    EL_DEBUG_CSE
+    FullToBand( uplo, A, bandwidth, householderScalars, signature );
+    Matrix<Field> W;
+    GetBand( A, bandwidth, W );
+    BandToTridiag( W, d, dSub, reflectors, mpi::COMM_SELF, storeReflectors );
+}
+
+template<typename Field>
+void TwoStage
+( UpperOrLower uplo,
+  AbstractDistMatrix<Field>& A,
+  Int bandwidth,
+  AbstractDistMatrix<Field>& householderScalars,
+  AbstractDistMatrix<Base<Field>>& signature,
+  Matrix<Base<Field>>& d,
+  Matrix<Field>& dSub,
+  BulgeChaseReflectors<Field>& reflectors,
+  bool storeReflectors )
+{
+    EL_DEBUG_CSE
+    FullToBand( uplo, A, bandwidth, householderScalars, signature );
+    Matrix<Field> W;
+    GetBand( A, bandwidth, W );
+    BandToTridiag
+    ( W, d, dSub, reflectors, A.Grid().Comm(), storeReflectors );
+}
+
+template<typename Field>
+void ApplyTwoStageQ
+( const Matrix<Field>& A,
+  Int bandwidth,
+  const Matrix<Field>& householderScalars,
+  const Matrix<Base<Field>>& signature,
+  const BulgeChaseReflectors<Field>& reflectors,
+        Matrix<Field>& B )
+{
+    EL_DEBUG_CSE
+    ApplyBulgeChaseQ( reflectors, B );
+    ApplyBandQ( A, bandwidth, householderScalars, signature, B );
+}
+
+template<typename Field>
+void ApplyTwoStageQ
+( const AbstractDistMatrix<Field>& A,
+  Int bandwidth,
+  const AbstractDistMatrix<Field>& householderScalars,
+  const AbstractDistMatrix<Base<Field>>& signature,
+  const BulgeChaseReflectors<Field>& reflectors,
+        AbstractDistMatrix<Field>& B )
+{
+    EL_DEBUG_CSE
+    ApplyBulgeChaseQ( reflectors, B );
+    ApplyBandQ( A, bandwidth, householderScalars, signature, B );
+}
+
+} // namespace herm_tridiag
+} // namespace El
+
+#endif // ifndef EL_CONDENSE_HERMITIAN_TRIDIAG_TWO_STAGE_HPP
@@ -347,16 +347,18 @@ Int SolveAfter
 // LU
 // ==
 
-// NOTE: This is not yet made use of, but the fully-pivoted version of LU
-//       should (soon?) accept it as an argument and potentially return one or
-//       more of the permutation matrices as the identity
+// NOTE: This is only made use of by the single-permutation LU below, but the
+//       fully-pivoted version of LU should (soon?) accept it as an argument
+//       and potentially return one or more of the permutation matrices as
+//       the identity
 namespace LUPivotTypeNS {
 enum LUPivotType
 {
     LU_PARTIAL,
     LU_FULL,
     LU_ROOK, /* not yet supported */
-    LU_WITHOUT_PIVOTING
+    LU_WITHOUT_PIVOTING,
+    LU_TOURNAMENT /* communication-avoiding (CALU) tournament pivoting */
 };
 }
 using namespace LUPivotTypeNS;
@@ -377,6 +379,18 @@ void LU( Matrix<Field>& A, Permutation& P );
 template<typename Field>
 void LU( AbstractDistMatrix<Field>& A, DistPermutation& P );
 
+// LU with a choice of row pivoting
+// --------------------------------
+// Supports LU_PARTIAL, LU_TOURNAMENT, and LU_WITHOUT_PIVOTING (in which case
+// P is the identity). Tournament pivoting chooses the pivots of each panel of
+// Blocksize() columns using a single reduction tree rather than a reduction
+// per column, at the cost of a (typically modestly) larger growth factor.
+template<typename Field>
+void LU( Matrix<Field>& A, Permutation& P, LUPivotType pivotType );
+template<typename Field>
+void LU
+( AbstractDistMatrix<Field>& A, DistPermutation& P, LUPivotType pivotType );
+
 // LU with full pivoting
 // ---------------------
 // P A Q^T = L U
@@ -779,6 +793,31 @@ void Scatter( AbstractDistMatrix<Field>& A, const TreeData<Field>& treeData );
 
 } // namespace qr
 
+// Tall-skinny QR with an automatic choice of algorithm
+// ----------------------------------------------------
+// Overwrite the (tall-skinny) A with Q and return R such that A = Q R, using
+// CholeskyQR2 when A is well-conditioned, shifted CholeskyQR3 when it is
+// moderately ill-conditioned, and Householder QR (TSQR in the distributed
+// case) otherwise. The condition number is estimated from the Cholesky
+// factor of the Gram matrix (using TwoNormEstimate), and each Cholesky pass
+// requires a single all-reduce over the [VC,STAR] rows of A. The algorithm
+// which was used is returned.
+namespace TallSkinnyQRAlgNS {
+enum TallSkinnyQRAlg
+{
+    TALL_SKINNY_CHOLESKY_QR2,
+    TALL_SKINNY_SHIFTED_CHOLESKY_QR3,
+    TALL_SKINNY_HOUSEHOLDER
+};
+}
+using namespace TallSkinnyQRAlgNS;
+
+template<typename Field>
+TallSkinnyQRAlg AutoTallSkinnyQR( Matrix<Field>& A, Matrix<Field>& R );
+template<typename Field>
+TallSkinnyQRAlg
+AutoTallSkinnyQR( AbstractDistMatrix<Field>& A, AbstractDistMatrix<Field>& R );
+
 // RQ
 // ==
 template<typename Field>
@@ -947,8 +986,125 @@ void Skeleton
         AbstractDistMatrix<Field>& Z,
   const QRCtrl<Base<Field>>& ctrl=QRCtrl<Base<Field>>() );
 
+// Out-of-core factorizations
+// ==========================
+// Left-looking factorizations of matrices which are stored as tiles on
+// node-local disk (see DiskMatrix) rather than in memory. Only a few block
+// columns of width A.TileSize() are held in memory at any time, and, if
+// requested, the reading of the next block column and the writing of the
+// last factored block column are overlapped with computation.
+//
+// Redistributions are avoided if the tile size is a multiple of both grid
+// dimensions.
+struct OutOfCoreCtrl
+{
+    bool asyncIO=true;
+    bool progress=false;
+};
+
+// Overwrite the lower triangle of A with its Cholesky factor (only
+// uplo=LOWER is currently supported, and only the lower triangle of A is read)
+template<typename Field>
+void Cholesky
+( UpperOrLower uplo,
+  DiskMatrix<Field>& A,
+  const OutOfCoreCtrl& ctrl=OutOfCoreCtrl() );
+
+// Overwrite A with its partially-pivoted LU factorization, P A = L U
+template<typename Field>
+void LU
+( DiskMatrix<Field>& A,
+  DistPermutation& P,
+  const OutOfCoreCtrl& ctrl=OutOfCoreCtrl() );
+
+namespace ooc {
+
+// Read/write the tiles (I0,J), (I0+1,J), ... of block column J of A from/to
+// a matrix whose first row corresponds to the first row of tile I0
+template<typename Field>
+void ReadPanel
+( const DiskMatrix<Field>& A,
+  Int J,
+  Int I0,
+  AbstractDistMatrix<Field>& panel );
+template<typename Field>
+void WritePanel
+( const DiskMatrix<Field>& A,
+  Int J,
+  Int I0,
+  const AbstractDistMatrix<Field>& panel );
+
+} // namespace ooc
+
+// Batched factorizations
+// ======================
+// Factorizations of many independent small matrices. A batch of m x n
+// matrices is either given by a pointer to the first matrix, the common
+// leading dimension, and the stride between the first entries of consecutive
+// matrices, or stored contiguously as the m x (batchSize n) matrix
+// [A_0, A_1, ...]. Distributed batches are [STAR,VC] block matrices whose
+// block width is a multiple of n (and whose row cut is zero), so that each
+// process owns whole matrices and factors them without communication.
+//
+// Each process factors its matrices in parallel over OpenMP threads, using
+// kernels specialized to the matrix width when it is at most
+// batched::maxFixedWidth. Quantities with one column per matrix (e.g., the
+// Householder scalars) are returned as batches of the same form.
+
+// Returns the number of matrices which were not numerically HPD, and, if
+// requested, sets info(k) to zero if A_k was HPD and to a positive value
+// otherwise. The factorizations of the other matrices are unaffected.
+template<typename Field>
+Int BatchedCholesky
+( UpperOrLower uplo,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Int* info=nullptr );
+template<typename Field>
+Int BatchedCholesky
+( UpperOrLower uplo,
+  Matrix<Field>& A,
+  Matrix<Int>& info );
+template<typename Field>
+Int BatchedCholesky
+( UpperOrLower uplo,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Int,STAR,VC,BLOCK>& info );
+
+// The Householder scalars and signature of A_k are stored in the k'th
+// min(m,n)-length segments of the respective buffers (or in column k)
+template<typename Field>
+void BatchedQR
+( Int m,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Field* householderScalars,
+  Base<Field>* signature );
+template<typename Field>
+void BatchedQR
+( Int n,
+  Matrix<Field>& A,
+  Matrix<Field>& householderScalars,
+  Matrix<Base<Field>>& signature );
+template<typename Field>
+void BatchedQR
+( Int n,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Field,STAR,VC,BLOCK>& householderScalars,
+  DistMatrix<Base<Field>,STAR,VC,BLOCK>& signature );
+
 } // namespace El
 
 #include <El/lapack_like/factor/qr/ProxyHouseholder.hpp>
+#include <El/lapack_like/factor/lu/Tournament.hpp>
+#include <El/lapack_like/factor/qr/AutoTallSkinny.hpp>
+#include <El/lapack_like/factor/OutOfCore.hpp>
+#include <El/lapack_like/factor/Batched.hpp>
 
 #endif // ifndef EL_FACTOR_HPP
@@ -0,0 +1,392 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_FACTOR_BATCHED_HPP
+#define EL_FACTOR_BATCHED_HPP
+
+namespace El {
+namespace batched {
+
+// Matrices of at most this width are handled by kernels whose loop bounds are
+// compile-time constants. Wider Cholesky factorizations are blocked over such
+// kernels, while wider QR factorizations and SVDs call the sequential
+// routines on each matrix.
+const Int maxFixedWidth = 8;
+
+// Apply 'func' to each index of the batch, in parallel over OpenMP threads.
+// Since exceptions may not leave an OpenMP parallel region, the first failure
+// is recorded and rethrown once the loop has completed.
+template<typename Function>
+void ForEach( Int batchSize, Function func )
+{
+    EL_DEBUG_CSE
+    std::mutex failureMutex;
+    bool failed = false;
+    string failure;
+    EL_PARALLEL_FOR
+    for( Int k=0; k<batchSize; ++k )
+    {
+        try { func( k ); }
+        catch( std::exception& e )
+        {
+            std::lock_guard<std::mutex> lock( failureMutex );
+            if( !failed )
+            {
+                failed = true;
+                failure = e.what();
+            }
+        }
+    }
+    if( failed )
+        RuntimeError("Batched factorization failed: ",failure);
+}
+
+// Ensure that each process owns whole matrices of a distributed batch
+template<typename Ring>
+void AssertBatch( const DistMatrix<Ring,STAR,VC,BLOCK>& A, Int width )
+{
+    if( width <= 0 )
+        LogicError("Matrix width must be positive");
+    if( A.Width() % width != 0 )
+        LogicError
+        ("Batch width, ",A.Width(),", was not a multiple of ",width);
+    if( A.BlockWidth() % width != 0 || A.RowCut() != 0 )
+        LogicError
+        ("Each block of the batch must consist of whole ",width,
+         "-column matrices");
+}
+
+// Configure B to hold a batch of height x width matrices distributed in the
+// same manner as the batch of 'n'-column matrices A
+template<typename Ring,typename RingB>
+void BatchLike
+( const DistMatrix<Ring,STAR,VC,BLOCK>& A,
+        Int n,
+        Int height,
+        Int width,
+        DistMatrix<RingB,STAR,VC,BLOCK>& B )
+{
+    EL_DEBUG_CSE
+    B.SetGrid( A.Grid() );
+    B.AlignRows( Max((A.BlockWidth()/n)*width,Int(1)), A.RowAlign() );
+    B.Resize( height, (A.Width()/n)*width );
+}
+
+// Cholesky factorizations which return zero if A was numerically HPD and the
+// (one-based) index of the first non-positive pivot otherwise
+// ---------------------------------------------------------------------------
+template<Int N,typename Field>
+Int FixedCholesky( UpperOrLower uplo, Field* A, Int ldim )
+{
+    typedef Base<Field> Real;
+    if( uplo == LOWER )
+    {
+        for( Int j=0; j<N; ++j )
+        {
+            Real delta = RealPart(A[j+j*ldim]);
+            for( Int k=0; k<j; ++k )
+                delta -= RealPart(Conj(A[j+k*ldim])*A[j+k*ldim]);
+            if( !(delta > Real(0)) )
+                return j+1;
+            const Real deltaSqrt = Sqrt(delta);
+            A[j+j*ldim] = deltaSqrt;
+            for( Int i=j+1; i<N; ++i )
+            {
+                Field alpha = A[i+j*ldim];
+                for( Int k=0; k<j; ++k )
+                    alpha -= A[i+k*ldim]*Conj(A[j+k*ldim]);
+                A[i+j*ldim] = alpha / deltaSqrt;
+            }
+        }
+    }
+    else
+    {
+        for( Int j=0; j<N; ++j )
+        {
+            Real delta = RealPart(A[j+j*ldim]);
+            for( Int k=0; k<j; ++k )
+                delta -= RealPart(Conj(A[k+j*ldim])*A[k+j*ldim]);
+            if( !(delta > Real(0)) )
+                return j+1;
+            const Real deltaSqrt = Sqrt(delta);
+            A[j+j*ldim] = deltaSqrt;
+            for( Int i=j+1; i<N; ++i )
+            {
+                Field alpha = A[j+i*ldim];
+                for( Int k=0; k<j; ++k )
+                    alpha -= Conj(A[k+j*ldim])*A[k+i*ldim];
+                A[j+i*ldim] = alpha / deltaSqrt;
+            }
+        }
+    }
+    return 0;
+}
+
+template<typename Field>
+Int Cholesky( UpperOrLower uplo, Int n, Field* A, Int ldim )
+{
+    switch( n )
+    {
+    case 0: return 0;
+    case 1: return FixedCholesky<1>( uplo, A, ldim );
+    case 2: return FixedCholesky<2>( uplo, A, ldim );
+    case 3: return FixedCholesky<3>( uplo, A, ldim );
+    case 4: return FixedCholesky<4>( uplo, A, ldim );
+    case 5: return FixedCholesky<5>( uplo, A, ldim );
+    case 6: return FixedCholesky<6>( uplo, A, ldim );
+    case 7: return FixedCholesky<7>( uplo, A, ldim );
+    case 8: return FixedCholesky<8>( uplo, A, ldim );
+    default:
+    {
+        // Factor the diagonal blocks with the fixed-width kernels (so that
+        // the failing pivot is known) and update the trailing matrix with
+        // Trsm and Herk
+        typedef Base<Field> Real;
+        Matrix<Field> AView;
+        AView.Attach( n, n, A, ldim );
+        for( Int k=0; k<n; k+=maxFixedWidth )
+        {
+            const Int nb = Min(maxFixedWidth,n-k);
+            const Range<Int> ind1( k, k+nb ), ind2( k+nb, n );
+            const Int info = Cholesky( uplo, nb, &A[k+k*ldim], ldim );
+            if( info != 0 )
+                return k + info;
+
+            auto A11 = AView( ind1, ind1 );
+            auto A22 = AView( ind2, ind2 );
+            if( uplo == LOWER )
+            {
+                auto A21 = AView( ind2, ind1 );
+                Trsm( RIGHT, LOWER, ADJOINT, NON_UNIT, Field(1), A11, A21 );
+                Herk( LOWER, NORMAL, Real(-1), A21, Real(1), A22 );
+            }
+            else
+            {
+                auto A12 = AView( ind1, ind2 );
+                Trsm( LEFT, UPPER, ADJOINT, NON_UNIT, Field(1), A11, A12 );
+                Herk( UPPER, ADJOINT, Real(-1), A12, Real(1), A22 );
+            }
+        }
+        return 0;
+    }
+    }
+}
+
+// Unblocked Householder QR factorizations following the conventions of QR,
+// so that the results may be used with qr::ApplyQ and qr::SolveAfter
+// ------------------------------------------------------------------------
+template<Int N,typename Field>
+void FixedQR
+( Int m,
+  Field* A,
+  Int ldim,
+  Field* householderScalars,
+  Base<Field>* signature )
+{
+    typedef Base<Field> Real;
+    const Int minDim = Min(m,N);
+    Matrix<Field> x;
+    for( Int j=0; j<minDim; ++j )
+    {
+        x.Attach( m-j-1, 1, &A[(j+1)+j*ldim], Max(m-j-1,Int(1)) );
+        const Field tau = LeftReflector( A[j+j*ldim], x );
+        householderScalars[j] = tau;
+
+        // A(j:m,j+1:N) := (I - tau [1; x] [1; x]^H) A(j:m,j+1:N)
+        for( Int jj=j+1; jj<N; ++jj )
+        {
+            Field gamma = A[j+jj*ldim];
+            for( Int i=j+1; i<m; ++i )
+                gamma += Conj(A[i+j*ldim])*A[i+jj*ldim];
+            gamma *= tau;
+            A[j+jj*ldim] -= gamma;
+            for( Int i=j+1; i<m; ++i )
+                A[i+jj*ldim] -= gamma*A[i+j*ldim];
+        }
+    }
+
+    // Force the diagonal of R to be non-negative
+    for( Int j=0; j<minDim; ++j )
+    {
+        const Real sgn = RealPart(A[j+j*ldim]) >= Real(0) ? Real(1) : Real(-1);
+        signature[j] = sgn;
+        for( Int jj=j; jj<N; ++jj )
+            A[j+jj*ldim] *= sgn;
+    }
+}
+
+template<typename Field>
+void QR
+( Int m,
+  Int n,
+  Field* A,
+  Int ldim,
+  Field* householderScalars,
+  Base<Field>* signature )
+{
+    switch( n )
+    {
+    case 0: return;
+    case 1: FixedQR<1>( m, A, ldim, householderScalars, signature ); return;
+    case 2: FixedQR<2>( m, A, ldim, householderScalars, signature ); return;
+    case 3: FixedQR<3>( m, A, ldim, householderScalars, signature ); return;
+    case 4: FixedQR<4>( m, A, ldim, householderScalars, signature ); return;
+    case 5: FixedQR<5>( m, A, ldim, householderScalars, signature ); return;
+    case 6: FixedQR<6>( m, A, ldim, householderScalars, signature ); return;
+    case 7: FixedQR<7>( m, A, ldim, householderScalars, signature ); return;
+    case 8: FixedQR<8>( m, A, ldim, householderScalars, signature ); return;
+    default:
+    {
+        const Int minDim = Min(m,n);
+        Matrix<Field> AView, householderScalarsView;
+        Matrix<Base<Field>> signatureView;
+        AView.Attach( m, n, A, ldim );
+        householderScalarsView.Attach
+        ( minDim, 1, householderScalars, Max(minDim,Int(1)) );
+        signatureView.Attach( minDim, 1, signature, Max(minDim,Int(1)) );
+        El::QR( AView, householderScalarsView, signatureView );
+    }
+    }
+}
+
+} // namespace batched
+
+// Batched Cholesky
+// ================
+template<typename Field>
+Int BatchedCholesky
+( UpperOrLower uplo,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Int* info )
+{
+    EL_DEBUG_CSE
+    std::atomic<Int> numFailures(0);
+    batched::ForEach
+    ( batchSize,
+      [&]( Int k )
+      {
+          const Int status =
+            batched::Cholesky( uplo, n, &A[k*stride], ldim );
+          if( info != nullptr )
+              info[k] = status;
+          if( status != 0 )
+              ++numFailures;
+      } );
+    return numFailures;
+}
+
+template<typename Field>
+Int BatchedCholesky
+( UpperOrLower uplo,
+  Matrix<Field>& A,
+  Matrix<Int>& info )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    if( n == 0 )
+    {
+        info.Resize( 1, 0 );
+        return 0;
+    }
+    if( A.Width() % n != 0 )
+        LogicError("Batch width, ",A.Width(),", was not a multiple of ",n);
+    const Int batchSize = A.Width() / n;
+    info.Resize( 1, batchSize );
+    return BatchedCholesky
+    ( uplo, n, batchSize, A.Buffer(), A.LDim(), n*A.LDim(), info.Buffer() );
+}
+
+template<typename Field>
+Int BatchedCholesky
+( UpperOrLower uplo,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Int,STAR,VC,BLOCK>& info )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    if( n == 0 )
+    {
+        info.SetGrid( A.Grid() );
+        info.Resize( 1, 0 );
+        return 0;
+    }
+    batched::AssertBatch( A, n );
+    batched::BatchLike( A, n, 1, 1, info );
+    const Int numLocalFailures =
+      BatchedCholesky( uplo, A.Matrix(), info.Matrix() );
+    return mpi::AllReduce( numLocalFailures, A.Grid().Comm() );
+}
+
+// Batched QR
+// ==========
+template<typename Field>
+void BatchedQR
+( Int m,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Field* householderScalars,
+  Base<Field>* signature )
+{
+    EL_DEBUG_CSE
+    const Int minDim = Min(m,n);
+    batched::ForEach
+    ( batchSize,
+      [&]( Int k )
+      {
+          batched::QR
+          ( m, n, &A[k*stride], ldim,
+            &householderScalars[k*minDim], &signature[k*minDim] );
+      } );
+}
+
+template<typename Field>
+void BatchedQR
+( Int n,
+  Matrix<Field>& A,
+  Matrix<Field>& householderScalars,
+  Matrix<Base<Field>>& signature )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int minDim = Min(m,n);
+    if( n <= 0 || A.Width() % n != 0 )
+        LogicError("Batch width, ",A.Width(),", was not a multiple of ",n);
+    const Int batchSize = A.Width() / n;
+    householderScalars.Resize( minDim, batchSize, Max(minDim,Int(1)) );
+    signature.Resize( minDim, batchSize, Max(minDim,Int(1)) );
+    BatchedQR
+    ( m, n, batchSize, A.Buffer(), A.LDim(), n*A.LDim(),
+      householderScalars.Buffer(), signature.Buffer() );
+}
+
+template<typename Field>
+void BatchedQR
+( Int n,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Field,STAR,VC,BLOCK>& householderScalars,
+  DistMatrix<Base<Field>,STAR,VC,BLOCK>& signature )
+{
+    EL_DEBUG_CSE
+    const Int minDim = Min(A.Height(),n);
+    batched::AssertBatch( A, n );
+    batched::BatchLike( A, n, minDim, 1, householderScalars );
+    batched::BatchLike( A, n, minDim, 1, signature );
+    BatchedQR
+    ( n, A.Matrix(), householderScalars.Matrix(), signature.Matrix() );
+}
+
+} // namespace El
+
+#endif // ifndef EL_FACTOR_BATCHED_HPP
@@ -0,0 +1,399 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_FACTOR_OUTOFCORE_HPP
+#define EL_FACTOR_OUTOFCORE_HPP
+
+namespace El {
+namespace ooc {
+
+// Both factorizations below are left-looking: block column J is read from
+// disk, updated using each of the previously factored block columns K < J
+// (which are streamed back in from disk, with the read of K+1 overlapping the
+// update from K), factored, and then written back to disk while the next
+// block column is processed. Only block column J, the block column currently
+// being streamed in, the one being prefetched, and the last factored block
+// column (which is kept in memory) are resident at any time.
+//
+// All communication takes place on the calling thread; the asynchronous tasks
+// only move the local portions of tiles to and from disk.
+
+// Redistribute between the local tile format of DiskMatrix and an [MC,MR]
+// block column whose first row is the first row of tile I0
+// --------------------------------------------------------------------------
+template<typename Field>
+void UnpackTiles
+( const DiskMatrix<Field>& A,
+        Int J,
+        Int I0,
+  const vector<Matrix<Field>>& tiles,
+        DistMatrix<Field>& panel )
+{
+    EL_DEBUG_CSE
+    const Int nb = A.TileSize();
+    const Int numTiles = tiles.size();
+    Int height = 0;
+    for( Int I=I0; I<I0+numTiles; ++I )
+        height += A.TileHeight( I );
+    panel.Resize( height, A.TileWidth(J) );
+
+    DistMatrix<Field> tile(A.Grid());
+    for( Int I=I0; I<I0+numTiles; ++I )
+    {
+        const Int offset = (I-I0)*nb;
+        tile.Resize( A.TileHeight(I), A.TileWidth(J) );
+        tile.Matrix() = tiles[I-I0];
+        auto panelTile = panel( IR(offset,offset+A.TileHeight(I)), ALL );
+        panelTile = tile;
+    }
+}
+
+template<typename Field>
+void PackTiles
+( const DiskMatrix<Field>& A,
+        Int I0,
+  const DistMatrix<Field>& panel,
+        vector<Matrix<Field>>& tiles )
+{
+    EL_DEBUG_CSE
+    const Int nb = A.TileSize();
+    const Int numTiles = A.NumTileRows() - I0;
+    tiles.resize( numTiles );
+
+    DistMatrix<Field> tile(A.Grid());
+    tile.Align( 0, 0 );
+    for( Int I=I0; I<I0+numTiles; ++I )
+    {
+        const Int offset = (I-I0)*nb;
+        tile = panel( IR(offset,offset+A.TileHeight(I)), ALL );
+        tiles[I-I0] = tile.LockedMatrix();
+    }
+}
+
+template<typename Field>
+void ReadPanel
+( const DiskMatrix<Field>& A,
+  Int J,
+  Int I0,
+  AbstractDistMatrix<Field>& panel )
+{
+    EL_DEBUG_CSE
+    vector<Matrix<Field>> tiles;
+    A.ReadLocalTiles( J, I0, A.NumTileRows(), tiles );
+    DistMatrix<Field> panelTiled(A.Grid());
+    UnpackTiles( A, J, I0, tiles, panelTiled );
+    Copy( panelTiled, panel );
+}
+
+template<typename Field>
+void WritePanel
+( const DiskMatrix<Field>& A,
+  Int J,
+  Int I0,
+  const AbstractDistMatrix<Field>& panel )
+{
+    EL_DEBUG_CSE
+    if( panel.Height() != A.Height()-I0*A.TileSize() ||
+        panel.Width() != A.TileWidth(J) )
+        LogicError
+        ("Expected a ",A.Height()-I0*A.TileSize()," x ",A.TileWidth(J),
+         " block column but received a ",panel.Height()," x ",panel.Width(),
+         " matrix");
+    DistMatrix<Field> panelTiled(A.Grid());
+    panelTiled = panel;
+    vector<Matrix<Field>> tiles;
+    PackTiles( A, I0, panelTiled, tiles );
+    A.WriteLocalTiles( J, I0, A.NumTileRows(), tiles );
+}
+
+// Asynchronous transfers of the local tiles of block columns
+// ----------------------------------------------------------
+template<typename Field>
+std::future<vector<Matrix<Field>>> StartRead
+( const DiskMatrix<Field>& A,
+        Int J,
+        Int I0,
+        vector<std::future<void>>& writes,
+  const OutOfCoreCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    // Ensure that the block column is not still being written
+    if( writes[J].valid() )
+        writes[J].get();
+    const Int I1 = A.NumTileRows();
+    auto read = [&A,J,I0,I1]()
+      {
+          vector<Matrix<Field>> tiles;
+          A.ReadLocalTiles( J, I0, I1, tiles );
+          return tiles;
+      };
+    // A deferred read is simply performed when its result is requested
+    return std::async
+      ( ctrl.asyncIO ? std::launch::async : std::launch::deferred, read );
+}
+
+template<typename Field>
+void StartWrite
+( const DiskMatrix<Field>& A,
+        Int J,
+        Int I0,
+  const DistMatrix<Field>& panel,
+        vector<std::future<void>>& writes,
+  const OutOfCoreCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    if( writes[J].valid() )
+        writes[J].get();
+    auto tiles = std::make_shared<vector<Matrix<Field>>>();
+    PackTiles( A, I0, panel, *tiles );
+    const Int I1 = A.NumTileRows();
+    auto write = [&A,J,I0,I1,tiles]() { A.WriteLocalTiles(J,I0,I1,*tiles); };
+    if( ctrl.asyncIO )
+        writes[J] = std::async( std::launch::async, write );
+    else
+        write();
+}
+
+inline void FinishWrites( vector<std::future<void>>& writes )
+{
+    EL_DEBUG_CSE
+    for( auto& write : writes )
+        if( write.valid() )
+            write.get();
+}
+
+} // namespace ooc
+
+template<typename Field>
+void Cholesky
+( UpperOrLower uplo,
+  DiskMatrix<Field>& A,
+  const OutOfCoreCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    if( uplo == UPPER )
+        LogicError("Out-of-core Cholesky only supports uplo=LOWER");
+    if( A.Height() != A.Width() )
+        LogicError("A must be square");
+    const Grid& g = A.Grid();
+    const Int numTiles = A.NumTileCols();
+    const Int nb = A.TileSize();
+
+    vector<std::future<void>> writes(numTiles);
+    std::future<vector<Matrix<Field>>> nextRead;
+
+    Timer timer;
+    DistMatrix<Field> AJ(g), LK(g), LLast(g);
+    DistMatrix<Field,MC,  STAR> LK_MC_STAR(g);
+    DistMatrix<Field,MR,  STAR> LKTop_MR_STAR(g);
+    DistMatrix<Field,STAR,STAR> AJJ_STAR_STAR(g);
+    DistMatrix<Field,VC,  STAR> AJB_VC_STAR(g);
+    for( Int J=0; J<numTiles; ++J )
+    {
+        if( ctrl.progress )
+            timer.Start();
+        const Int jb = A.TileWidth( J );
+
+        // Read the lower portion of block column J and begin prefetching the
+        // first previously-factored block column which is not in memory
+        auto read = ooc::StartRead( A, J, J, writes, ctrl );
+        if( J > 1 )
+            nextRead = ooc::StartRead( A, 0, J, writes, ctrl );
+        ooc::UnpackTiles( A, J, J, read.get(), AJ );
+        auto AJJ = AJ( IR(0,jb), ALL );
+        auto AJB = AJ( IR(jb,END), ALL );
+
+        // A(J:n,J) -= L(J:n,K) L(J,K)^H for each K < J
+        // --------------------------------------------
+        for( Int K=0; K<J; ++K )
+        {
+            if( K < J-1 )
+            {
+                ooc::UnpackTiles( A, K, J, nextRead.get(), LK );
+                if( K+1 < J-1 )
+                    nextRead = ooc::StartRead( A, K+1, J, writes, ctrl );
+            }
+            else
+                LK = LLast( IR(nb,END), ALL );
+
+            LK_MC_STAR.AlignWith( AJ );
+            LK_MC_STAR = LK;
+            LKTop_MR_STAR.AlignWith( AJ );
+            LKTop_MR_STAR = LK( IR(0,jb), ALL );
+            LocalTrrk
+            ( LOWER, ADJOINT,
+              Field(-1), LK_MC_STAR( IR(0,jb), ALL ), LKTop_MR_STAR,
+              Field(1), AJJ );
+            LocalGemm
+            ( NORMAL, ADJOINT,
+              Field(-1), LK_MC_STAR( IR(jb,END), ALL ), LKTop_MR_STAR,
+              Field(1), AJB );
+        }
+
+        // Factor block column J
+        // ---------------------
+        AJJ_STAR_STAR = AJJ;
+        Cholesky( LOWER, AJJ_STAR_STAR.Matrix() );
+        AJJ = AJJ_STAR_STAR;
+
+        AJB_VC_STAR.AlignWith( AJB );
+        AJB_VC_STAR = AJB;
+        LocalTrsm
+        ( RIGHT, LOWER, ADJOINT, NON_UNIT,
+          Field(1), AJJ_STAR_STAR, AJB_VC_STAR );
+        AJB = AJB_VC_STAR;
+
+        ooc::StartWrite( A, J, J, AJ, writes, ctrl );
+        LLast = AJ;
+
+        if( ctrl.progress )
+        {
+            const double panelTime = timer.Stop();
+            if( g.Rank() == 0 )
+                Output
+                ("Block column ",J," of ",numTiles," took ",panelTime,
+                 " seconds");
+        }
+    }
+    ooc::FinishWrites( writes );
+}
+
+template<typename Field>
+void LU
+( DiskMatrix<Field>& A,
+  DistPermutation& P,
+  const OutOfCoreCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    if( A.Height() != A.Width() )
+        LogicError("A must be square");
+    const Grid& g = A.Grid();
+    const Int n = A.Height();
+    const Int numTiles = A.NumTileCols();
+    const Int nb = A.TileSize();
+
+    vector<std::future<void>> writes(numTiles);
+    std::future<vector<Matrix<Field>>> nextRead;
+    vector<unique_ptr<DistPermutation>> pivots(numTiles);
+
+    Timer timer;
+    DistMatrix<Field> AJ(g), LK(g), LLast(g);
+    DistMatrix<Field,STAR,STAR> LKK_STAR_STAR(g);
+    DistMatrix<Field,MC,  STAR> LKB_MC_STAR(g);
+    DistMatrix<Field,STAR,VR  > UKJ_STAR_VR(g);
+    DistMatrix<Field,STAR,MR  > UKJ_STAR_MR(g);
+    for( Int J=0; J<numTiles; ++J )
+    {
+        if( ctrl.progress )
+            timer.Start();
+
+        // Read all of block column J and begin prefetching the first
+        // previously-factored block column which is not in memory
+        auto read = ooc::StartRead( A, J, 0, writes, ctrl );
+        if( J > 1 )
+            nextRead = ooc::StartRead( A, 0, 0, writes, ctrl );
+        ooc::UnpackTiles( A, J, 0, read.get(), AJ );
+
+        // Apply the row swaps from the factorizations of the previous block
+        // columns. Since the updates below are row-wise, they commute with
+        // the swaps as long as the stored portions of L are swapped as well.
+        for( Int K=0; K<J; ++K )
+        {
+            auto AJBelow = AJ( IR(K*nb,END), ALL );
+            pivots[K]->PermuteRows( AJBelow );
+        }
+
+        // Apply the updates from each of the previous block columns
+        // ---------------------------------------------------------
+        for( Int K=0; K<J; ++K )
+        {
+            if( K < J-1 )
+            {
+                ooc::UnpackTiles( A, K, K, nextRead.get(), LK );
+                if( K+1 < J-1 )
+                    nextRead = ooc::StartRead( A, K+1, K+1, writes, ctrl );
+                // Lazily apply the swaps from the subsequent block columns
+                for( Int I=K+1; I<J; ++I )
+                {
+                    auto LKBelow = LK( IR((I-K)*nb,END), ALL );
+                    pivots[I]->PermuteRows( LKBelow );
+                }
+            }
+            else
+                LK = LLast;
+            auto LKK = LK( IR(0,nb), ALL );
+            auto LKB = LK( IR(nb,END), ALL );
+            auto UKJ = AJ( IR(K*nb,(K+1)*nb), ALL );
+            auto AJBelow = AJ( IR((K+1)*nb,END), ALL );
+
+            // U(K,J) := inv(L(K,K)) A(K,J)
+            LKK_STAR_STAR = LKK;
+            UKJ_STAR_VR = UKJ;
+            LocalTrsm
+            ( LEFT, LOWER, NORMAL, UNIT,
+              Field(1), LKK_STAR_STAR, UKJ_STAR_VR );
+            UKJ_STAR_MR.AlignWith( AJBelow );
+            UKJ_STAR_MR = UKJ_STAR_VR;
+            UKJ = UKJ_STAR_MR;
+
+            // A(K+1:n,J) -= L(K+1:n,K) U(K,J)
+            LKB_MC_STAR.AlignWith( AJBelow );
+            LKB_MC_STAR = LKB;
+            LocalGemm
+            ( NORMAL, NORMAL,
+              Field(-1), LKB_MC_STAR, UKJ_STAR_MR, Field(1), AJBelow );
+        }
+
+        // Factor the lower portion of block column J
+        // ------------------------------------------
+        auto AJB = AJ( IR(J*nb,END), ALL );
+        pivots[J].reset( new DistPermutation(g) );
+        LU( AJB, *pivots[J] );
+
+        ooc::StartWrite( A, J, 0, AJ, writes, ctrl );
+        LLast = AJB;
+
+        if( ctrl.progress )
+        {
+            const double panelTime = timer.Stop();
+            if( g.Rank() == 0 )
+                Output
+                ("Block column ",J," of ",numTiles," took ",panelTime,
+                 " seconds");
+        }
+    }
+
+    // Apply the swaps from subsequent block columns to each stored block of L
+    // -----------------------------------------------------------------------
+    if( numTiles > 1 )
+        nextRead = ooc::StartRead( A, 0, 1, writes, ctrl );
+    for( Int K=0; K<numTiles-1; ++K )
+    {
+        ooc::UnpackTiles( A, K, K+1, nextRead.get(), LK );
+        if( K+1 < numTiles-1 )
+            nextRead = ooc::StartRead( A, K+1, K+2, writes, ctrl );
+        for( Int I=K+1; I<numTiles; ++I )
+        {
+            auto LKBelow = LK( IR((I-K-1)*nb,END), ALL );
+            pivots[I]->PermuteRows( LKBelow );
+        }
+        ooc::StartWrite( A, K, K+1, LK, writes, ctrl );
+    }
+    ooc::FinishWrites( writes );
+
+    // Combine the swaps from each of the block columns
+    P.SetGrid( g );
+    P.MakeIdentity( n );
+    P.ReserveSwaps( n );
+    for( Int J=0; J<numTiles; ++J )
+        P.SwapSequence( *pivots[J], J*nb );
+}
+
+} // namespace El
+
+#endif // ifndef EL_FACTOR_OUTOFCORE_HPP
@@ -0,0 +1,379 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_LU_TOURNAMENT_HPP
+#define EL_LU_TOURNAMENT_HPP
+
+namespace El {
+namespace lu {
+
+// The following implements the communication-avoiding LU factorization with
+// tournament pivoting (CALU) from
+//
+//   L. Grigori, J.W. Demmel, and H. Xiang,
+//   "CALU: A communication optimal LU factorization algorithm",
+//   SIAM J. Matrix Anal. Appl., 32(4), pp. 1317--1350, 2011.
+//
+// Rather than choosing the pivot of each column of a panel with a separate
+// reduction, the nb pivot rows of an nb-wide panel are chosen at once: each
+// process selects nb candidate rows from its own rows of the panel using
+// partial pivoting, and pairs of candidate sets are then repeatedly stacked
+// and reduced back to nb rows (again using partial pivoting) up a binary
+// tree. The winners are swapped to the top of the panel, which can then be
+// factored without further pivoting.
+
+template<typename Field>
+struct TournamentCandidates
+{
+    // The original global row indices (relative to the panel)
+    vector<Int> rows;
+    // The original values of the candidate rows
+    Matrix<Field> values;
+};
+
+// Select (up to) nb of the given rows using partial pivoting. Unlike LU, a
+// zero pivot (e.g., from an all-zero or rank-deficient block of rows) does
+// not raise an exception; the elimination step is skipped, so that nb rows
+// are selected from any block of at least nb rows.
+template<typename Field>
+void SelectCandidates
+( const Matrix<Field>& values,
+  const vector<Int>& rows,
+        Int nb,
+        TournamentCandidates<Field>& winners )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int numRows = values.Height();
+    const Int width = values.Width();
+    const Int numWinners = Min( nb, numRows );
+    Matrix<Field> B( values );
+    Field* BBuf = B.Buffer();
+    const Int BLDim = B.LDim();
+    vector<Int> order( numRows );
+    for( Int i=0; i<numRows; ++i )
+        order[i] = i;
+    for( Int k=0; k<Min(numWinners,width); ++k )
+    {
+        Int iPiv = k;
+        Real maxAbs = Abs( BBuf[k+k*BLDim] );
+        for( Int i=k+1; i<numRows; ++i )
+        {
+            const Real absVal = Abs( BBuf[i+k*BLDim] );
+            if( absVal > maxAbs )
+            {
+                iPiv = i;
+                maxAbs = absVal;
+            }
+        }
+        if( iPiv != k )
+        {
+            std::swap( order[k], order[iPiv] );
+            for( Int j=0; j<width; ++j )
+                std::swap( BBuf[k+j*BLDim], BBuf[iPiv+j*BLDim] );
+        }
+        if( maxAbs == Real(0) )
+            continue;
+
+        const Field pivot = BBuf[k+k*BLDim];
+        for( Int i=k+1; i<numRows; ++i )
+            BBuf[i+k*BLDim] /= pivot;
+        for( Int j=k+1; j<width; ++j )
+        {
+            const Field beta = BBuf[k+j*BLDim];
+            for( Int i=k+1; i<numRows; ++i )
+                BBuf[i+j*BLDim] -= BBuf[i+k*BLDim]*beta;
+        }
+    }
+
+    winners.rows.resize( numWinners );
+    Zeros( winners.values, numWinners, width );
+    for( Int i=0; i<numWinners; ++i )
+    {
+        const Int origin = order[i];
+        winners.rows[i] = rows[origin];
+        auto winnerRow = winners.values( IR(i), ALL );
+        winnerRow = values( IR(origin), ALL );
+    }
+}
+
+// Stack two sets of candidates and keep the best nb rows in the first
+template<typename Field>
+void PlayMatch
+(       TournamentCandidates<Field>& A,
+  const TournamentCandidates<Field>& B,
+        Int nb )
+{
+    EL_DEBUG_CSE
+    const Int numA = A.rows.size();
+    const Int numB = B.rows.size();
+    Matrix<Field> stacked;
+    Zeros( stacked, numA+numB, A.values.Width() );
+    auto stackedA = stacked( IR(0,numA), ALL );
+    auto stackedB = stacked( IR(numA,END), ALL );
+    stackedA = A.values;
+    stackedB = B.values;
+    vector<Int> rows( A.rows );
+    rows.insert( rows.end(), B.rows.begin(), B.rows.end() );
+    SelectCandidates( stacked, rows, nb, A );
+}
+
+// Play the tournament over chunks of the rows of a local panel
+template<typename Field>
+void TournamentPivots
+( const Matrix<Field>& panel,
+        vector<Int>& winners,
+        Int chunkSize )
+{
+    EL_DEBUG_CSE
+    const Int m = panel.Height();
+    const Int nb = panel.Width();
+    chunkSize = Max( chunkSize, nb );
+    vector<TournamentCandidates<Field>> players;
+    vector<Int> rows;
+    for( Int i=0; i<m; i+=chunkSize )
+    {
+        const Int chunkHeight = Min( chunkSize, m-i );
+        rows.resize( chunkHeight );
+        for( Int j=0; j<chunkHeight; ++j )
+            rows[j] = i + j;
+        players.emplace_back();
+        SelectCandidates
+        ( panel(IR(i,i+chunkHeight),ALL), rows, nb, players.back() );
+    }
+    while( players.size() > 1 )
+    {
+        const Int numPlayers = players.size();
+        for( Int j=0; 2*j<numPlayers; ++j )
+        {
+            if( 2*j+1 < numPlayers )
+                PlayMatch( players[2*j], players[2*j+1], nb );
+            if( j > 0 )
+                std::swap( players[j], players[2*j] );
+        }
+        players.resize( (numPlayers+1)/2 );
+    }
+    winners = players[0].rows;
+}
+
+// Play the tournament over the processes owning the rows of a panel, which
+// requires a single reduction tree
+template<typename Field>
+void TournamentPivots
+( const DistMatrix<Field,VC,STAR>& panel,
+        vector<Int>& winners )
+{
+    EL_DEBUG_CSE
+    const Int nb = panel.Width();
+    mpi::Comm comm = panel.DistComm();
+    const int commRank = mpi::Rank( comm );
+    const int commSize = mpi::Size( comm );
+
+    const Int localHeight = panel.LocalHeight();
+    vector<Int> rows( localHeight );
+    for( Int iLoc=0; iLoc<localHeight; ++iLoc )
+        rows[iLoc] = panel.GlobalRow(iLoc);
+    TournamentCandidates<Field> mine, theirs;
+    SelectCandidates( panel.LockedMatrix(), rows, nb, mine );
+
+    for( int dist=1; dist<commSize; dist*=2 )
+    {
+        if( commRank % (2*dist) == dist )
+        {
+            const int numMine = mine.rows.size();
+            mpi::Send( numMine, commRank-dist, comm );
+            if( numMine > 0 )
+            {
+                mpi::Send( mine.rows.data(), numMine, commRank-dist, comm );
+                mpi::Send
+                ( mine.values.LockedBuffer(), numMine*nb, commRank-dist,
+                  comm );
+            }
+            break;
+        }
+        else if( commRank % (2*dist) == 0 && commRank+dist < commSize )
+        {
+            const int numTheirs = mpi::Recv<int>( commRank+dist, comm );
+            if( numTheirs > 0 )
+            {
+                theirs.rows.resize( numTheirs );
+                Zeros( theirs.values, numTheirs, nb );
+                mpi::Recv( theirs.rows.data(), numTheirs, commRank+dist, comm );
+                mpi::Recv
+                ( theirs.values.Buffer(), numTheirs*nb, commRank+dist, comm );
+                PlayMatch( mine, theirs, nb );
+            }
+        }
+    }
+
+    int numWinners = mine.rows.size();
+    mpi::Broadcast( numWinners, 0, comm );
+    winners = mine.rows;
+    winners.resize( numWinners );
+    mpi::Broadcast( winners.data(), numWinners, 0, comm );
+}
+
+// Form the swaps which move the winners, in order, to the top of the panel
+template<class PermutationType>
+void SwapWinnersToTop
+( const vector<Int>& winners,
+        Int panelHeight,
+        PermutationType& perm )
+{
+    EL_DEBUG_CSE
+    const Int numWinners = winners.size();
+    perm.MakeIdentity( panelHeight );
+    perm.ReserveSwaps( numWinners );
+    // Only the rows which have moved are tracked
+    std::map<Int,Int> rowAt, positionOf;
+    for( Int j=0; j<numWinners; ++j )
+    {
+        const Int winner = winners[j];
+        auto posIt = positionOf.find( winner );
+        const Int pos = ( posIt == positionOf.end() ? winner : posIt->second );
+        auto rowIt = rowAt.find( j );
+        const Int displaced = ( rowIt == rowAt.end() ? j : rowIt->second );
+        rowAt[j] = winner;
+        rowAt[pos] = displaced;
+        positionOf[winner] = j;
+        positionOf[displaced] = pos;
+        perm.Swap( j, pos );
+    }
+}
+
+template<typename Field>
+void Tournament( Matrix<Field>& A, Permutation& P )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    const Int minDim = Min(m,n);
+    P.MakeIdentity( m );
+    P.ReserveSwaps( minDim );
+
+    Permutation panelPerm;
+    vector<Int> winners;
+    const Int bsize = Blocksize();
+    for( Int k=0; k<minDim; k+=bsize )
+    {
+        const Int nb = Min(bsize,minDim-k);
+        const Range<Int> ind1( k, k+nb ), ind2( k+nb, END ), indB( k, END );
+
+        auto AB1 = A( indB, ind1 );
+        TournamentPivots( AB1, winners, 4*nb );
+        SwapWinnersToTop( winners, m-k, panelPerm );
+        auto AB = A( indB, ALL );
+        panelPerm.PermuteRows( AB );
+        P.SwapSequence( panelPerm, k );
+
+        auto A11 = A( ind1, ind1 );
+        auto A12 = A( ind1, ind2 );
+        auto A21 = A( ind2, ind1 );
+        auto A22 = A( ind2, ind2 );
+        LU( A11 );
+        Trsm( RIGHT, UPPER, NORMAL, NON_UNIT, Field(1), A11, A21 );
+        Trsm( LEFT, LOWER, NORMAL, UNIT, Field(1), A11, A12 );
+        Gemm( NORMAL, NORMAL, Field(-1), A21, A12, Field(1), A22 );
+    }
+}
+
+template<typename Field>
+void Tournament( AbstractDistMatrix<Field>& APre, DistPermutation& P )
+{
+    EL_DEBUG_CSE
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> AProx( APre );
+    auto& A = AProx.Get();
+
+    const Grid& g = A.Grid();
+    const Int m = A.Height();
+    const Int n = A.Width();
+    const Int minDim = Min(m,n);
+    P.SetGrid( g );
+    P.MakeIdentity( m );
+    P.ReserveSwaps( minDim );
+
+    DistPermutation panelPerm(g);
+    DistMatrix<Field,VC,STAR> AB1_VC_STAR(g);
+    DistMatrix<Field,STAR,STAR> A11_STAR_STAR(g);
+    vector<Int> winners;
+    const Int bsize = Blocksize();
+    for( Int k=0; k<minDim; k+=bsize )
+    {
+        const Int nb = Min(bsize,minDim-k);
+        const Range<Int> ind1( k, k+nb ), ind2( k+nb, END ), indB( k, END );
+
+        auto AB1 = A( indB, ind1 );
+        AB1_VC_STAR = AB1;
+        TournamentPivots( AB1_VC_STAR, winners );
+        SwapWinnersToTop( winners, m-k, panelPerm );
+        auto AB = A( indB, ALL );
+        panelPerm.PermuteRows( AB );
+        P.SwapSequence( panelPerm, k );
+
+        auto A11 = A( ind1, ind1 );
+        auto A12 = A( ind1, ind2 );
+        auto A21 = A( ind2, ind1 );
+        auto A22 = A( ind2, ind2 );
+        A11_STAR_STAR = A11;
+        LU( A11_STAR_STAR );
+        A11 = A11_STAR_STAR;
+        Trsm( RIGHT, UPPER, NORMAL, NON_UNIT, Field(1), A11_STAR_STAR, A21 );
+        Trsm( LEFT, LOWER, NORMAL, UNIT, Field(1), A11_STAR_STAR, A12 );
+        Gemm( NORMAL, NORMAL, Field(-1), A21, A12, Field(1), A22 );
+    }
+}
+
+} // namespace lu
+
+template<typename Field>
+void LU( Matrix<Field>& A, Permutation& P, LUPivotType pivotType )
+{
+    EL_DEBUG_CSE
+    switch( pivotType )
+    {
+    case LU_PARTIAL:
+        LU( A, P );
+        break;
+    case LU_TOURNAMENT:
+        lu::Tournament( A, P );
+        break;
+    case LU_WITHOUT_PIVOTING:
+        P.MakeIdentity( A.Height() );
+        LU( A );
+        break;
+    default:
+        LogicError("Unsupported pivot type for LU with a single permutation");
+    }
+}
+
+template<typename Field>
+void LU
+( AbstractDistMatrix<Field>& A, DistPermutation& P, LUPivotType pivotType )
+{
+    EL_DEBUG_CSE
+    switch( pivotType )
+    {
+    case LU_PARTIAL:
+        LU( A, P );
+        break;
+    case LU_TOURNAMENT:
+        lu::Tournament( A, P );
+        break;
+    case LU_WITHOUT_PIVOTING:
+        P.SetGrid( A.Grid() );
+        P.MakeIdentity( A.Height() );
+        LU( A );
+        break;
+    default:
+        LogicError("Unsupported pivot type for LU with a single permutation");
+    }
+}
+
+} // namespace El
+
+#endif // ifndef EL_LU_TOURNAMENT_HPP
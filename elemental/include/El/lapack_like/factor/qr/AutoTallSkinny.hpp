@@ -0,0 +1,197 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_QR_AUTO_TALL_SKINNY_HPP
+#define EL_QR_AUTO_TALL_SKINNY_HPP
+
+namespace El {
+namespace qr {
+namespace auto_ts {
+
+// The following chooses between the algorithms analyzed in
+//
+//   T. Fukaya, R. Kannan, Y. Nakatsukasa, Y. Yamamoto, and Y. Yanagisawa,
+//   "Shifted Cholesky QR for computing the QR factorization of
+//    ill-conditioned matrices", SIAM J. Sci. Comput., 42(1), 2020.
+//
+// CholeskyQR2 yields an orthogonality error of O(eps) as long as
+// kappa(A) = O(eps^{-1/2}), while a preliminary pass of Cholesky QR with a
+// diagonal shift of O(eps ||A||_2^2) reduces the condition number of any A
+// with kappa(A) = O(eps^{-1}) to O(eps^{-1/2}). Each pass requires a single
+// all-reduce of an n x n Gram matrix.
+
+// Form the Gram matrix of the rows of A distributed over 'comm' and attempt
+// to overwrite it with its upper Cholesky factor; returns false if the Gram
+// matrix was not numerically HPD (the result is the same on every process)
+template<typename Field>
+bool GramCholesky
+( const Matrix<Field>& A,
+        Matrix<Field>& R,
+        mpi::Comm comm,
+        Base<Field> shift=0 )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int n = A.Width();
+    Zeros( R, n, n );
+    Herk( UPPER, ADJOINT, Real(1), A, Real(0), R );
+    mpi::AllReduce( R.Buffer(), n*n, comm );
+    if( shift != Real(0) )
+        ShiftDiagonal( R, Field(shift) );
+    try
+    {
+        Cholesky( UPPER, R );
+    }
+    catch( const NonHPDMatrixException& )
+    {
+        return false;
+    }
+    MakeTrapezoidal( UPPER, R );
+    return true;
+}
+
+// An estimate of the two-norm condition number of a small upper-triangular
+// matrix which is redundantly stored over 'comm'. Since the power iterations
+// start from random vectors, the largest estimate is agreed upon so that
+// every process makes the same decision.
+template<typename Field>
+Base<Field> ConditionEstimate( const Matrix<Field>& R, mpi::Comm comm )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    for( Int j=0; j<R.Height(); ++j )
+        if( R(j,j) == Field(0) )
+            return limits::Infinity<Real>();
+    Matrix<Field> RInv( R );
+    TriangularInverse( UPPER, NON_UNIT, RInv );
+    const Real cond = TwoNormEstimate( R ) * TwoNormEstimate( RInv );
+    return mpi::AllReduce( cond, mpi::MAX, comm );
+}
+
+// A := A R^{-1} and RTotal := R RTotal
+template<typename Field>
+void ApplyPass
+(       Matrix<Field>& A,
+  const Matrix<Field>& R,
+        Matrix<Field>& RTotal )
+{
+    EL_DEBUG_CSE
+    Trsm( RIGHT, UPPER, NORMAL, NON_UNIT, Field(1), R, A );
+    Trmm( LEFT, UPPER, NORMAL, NON_UNIT, Field(1), R, RTotal );
+}
+
+// Overwrite the local rows of A with Q and return R on every process when
+// Cholesky-based QR is safe, or return the reason to fall back to a
+// Householder-based QR of the (partially orthogonalized) result
+template<typename Field>
+TallSkinnyQRAlg CholeskyPasses
+( Matrix<Field>& A,
+  Matrix<Field>& RTotal,
+  Int globalHeight,
+  Base<Field> twoNormEst,
+  mpi::Comm comm )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Real eps = limits::Epsilon<Real>();
+    const Int n = A.Width();
+    // The largest condition number for which CholeskyQR2 is trusted
+    const Real maxCond = 1/(8*Sqrt(eps));
+    Identity( RTotal, n, n );
+
+    Matrix<Field> R;
+    TallSkinnyQRAlg alg = TALL_SKINNY_CHOLESKY_QR2;
+    if( !GramCholesky( A, R, comm ) || ConditionEstimate(R,comm) > maxCond )
+    {
+        // Shifted Cholesky QR: use a shift just large enough to guarantee
+        // that the shifted Gram matrix is numerically HPD
+        alg = TALL_SKINNY_SHIFTED_CHOLESKY_QR3;
+        const Real shift =
+          11*(globalHeight*n + n*(n+1))*eps*twoNormEst*twoNormEst;
+        if( !GramCholesky( A, R, comm, shift ) )
+            return TALL_SKINNY_HOUSEHOLDER;
+        ApplyPass( A, R, RTotal );
+        if( !GramCholesky( A, R, comm ) || ConditionEstimate(R,comm) > maxCond )
+            return TALL_SKINNY_HOUSEHOLDER;
+    }
+
+    // Two (more) passes of Cholesky QR
+    ApplyPass( A, R, RTotal );
+    if( !GramCholesky( A, R, comm ) )
+        return TALL_SKINNY_HOUSEHOLDER;
+    ApplyPass( A, R, RTotal );
+    return alg;
+}
+
+} // namespace auto_ts
+} // namespace qr
+
+template<typename Field>
+TallSkinnyQRAlg AutoTallSkinnyQR( Matrix<Field>& A, Matrix<Field>& R )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    if( m < n )
+        LogicError("AutoTallSkinnyQR requires that A not be wide");
+    const Base<Field> twoNormEst = TwoNormEstimate( A );
+    const auto alg =
+      qr::auto_ts::CholeskyPasses( A, R, m, twoNormEst, mpi::COMM_SELF );
+    if( alg == TALL_SKINNY_HOUSEHOLDER )
+    {
+        // A currently holds A_orig R^{-1}
+        Matrix<Field> RHouse;
+        qr::Explicit( A, RHouse );
+        Trmm( LEFT, UPPER, NORMAL, NON_UNIT, Field(1), RHouse, R );
+    }
+    return alg;
+}
+
+template<typename Field>
+TallSkinnyQRAlg
+AutoTallSkinnyQR
+( AbstractDistMatrix<Field>& APre, AbstractDistMatrix<Field>& RPre )
+{
+    EL_DEBUG_CSE
+    const Int m = APre.Height();
+    const Int n = APre.Width();
+    if( m < n )
+        LogicError("AutoTallSkinnyQR requires that A not be wide");
+    const Base<Field> twoNormEst = TwoNormEstimate( APre );
+
+    DistMatrixReadWriteProxy<Field,Field,VC,STAR> AProx( APre );
+    auto& A = AProx.Get();
+    const Grid& g = A.Grid();
+
+    Matrix<Field> R;
+    const auto alg =
+      qr::auto_ts::CholeskyPasses
+      ( A.Matrix(), R, m, twoNormEst, A.DistComm() );
+    if( alg == TALL_SKINNY_HOUSEHOLDER )
+    {
+        // A currently holds A_orig R^{-1}. TSQR requires a power-of-two
+        // number of processes, each owning at least n rows.
+        DistMatrix<Field,STAR,STAR> RHouse(g);
+        const Int p = A.DistSize();
+        if( (p & (p-1)) == 0 && m >= p*n )
+            qr::ExplicitTS( A, RHouse );
+        else
+            qr::Explicit( A, RHouse );
+        Trmm( LEFT, UPPER, NORMAL, NON_UNIT, Field(1), RHouse.Matrix(), R );
+    }
+
+    DistMatrixWriteProxy<Field,Field,STAR,STAR> RProx( RPre );
+    auto& RSTAR = RProx.Get();
+    RSTAR.Resize( n, n );
+    Copy( R, RSTAR.Matrix() );
+    return alg;
+}
+
+} // namespace El
+
+#endif // ifndef EL_QR_AUTO_TALL_SKINNY_HPP
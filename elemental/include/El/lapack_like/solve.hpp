@@ -227,6 +227,71 @@ void Overwrite
 
 } // namespace hpd_solve
 
+// Mixed-precision solves
+// ======================
+// Factor A in the demoted precision (e.g., single rather than double) and
+// refine the solution to the working precision with GMRES-based iterative
+// refinement (see solve/MixedPrecision.hpp). If A cannot be represented or
+// factored in the demoted precision, or the refinement fails to converge,
+// the solve is (by default) repeated with a working-precision factorization.
+template<typename Real>
+struct MixedPrecisionCtrl
+{
+    // Stop once each column satisfies
+    //   || b - A x ||_2 <= relTol (|| A ||_F || x ||_2 + || b ||_2)
+    Real relTol=Real(10)*limits::Epsilon<Real>();
+    Int maxRefineIts=10;
+
+    // The parameters of the preconditioned FGMRES solves of the correction
+    // equations
+    Real innerRelTol=Pow(limits::Epsilon<Real>(),Real(0.25));
+    Int restart=30;
+    Int maxInnerIts=100;
+
+    bool fallback=true;
+    bool progress=false;
+};
+
+struct MixedPrecisionInfo
+{
+    Int numRefineIts=0;
+    // The sum, over the refinement steps, of the largest number of FGMRES
+    // iterations required by any of the right-hand sides
+    Int numInnerIts=0;
+    // Whether the system was instead solved in the working precision
+    bool fellBack=false;
+};
+
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionLinearSolve
+( const Matrix<Field>& A,
+        Matrix<Field>& B,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl=
+        MixedPrecisionCtrl<Base<Field>>() );
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionLinearSolve
+( const AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Field>& B,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl=
+        MixedPrecisionCtrl<Base<Field>>() );
+
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionHPDSolve
+( UpperOrLower uplo,
+  Orientation orientation,
+  const Matrix<Field>& A,
+        Matrix<Field>& B,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl=
+        MixedPrecisionCtrl<Base<Field>>() );
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionHPDSolve
+( UpperOrLower uplo,
+  Orientation orientation,
+  const AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Field>& B,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl=
+        MixedPrecisionCtrl<Base<Field>>() );
+
 // Multi-shift Hessenberg
 // ======================
 template<typename Field>
@@ -251,5 +316,6 @@ void MultiShiftHessSolve
 #include <El/lapack_like/solve/FGMRES.hpp>
 #include <El/lapack_like/solve/LGMRES.hpp>
 #include <El/lapack_like/solve/Refined.hpp>
+#include <El/lapack_like/solve/MixedPrecision.hpp>
 
 #endif // ifndef EL_SOLVE_HPP
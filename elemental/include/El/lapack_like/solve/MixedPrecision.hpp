@@ -0,0 +1,472 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_SOLVE_MIXED_PRECISION_HPP
+#define EL_SOLVE_MIXED_PRECISION_HPP
+
+// GMRES-based iterative refinement (GMRES-IR), as analyzed in
+//
+//   E. Carson and N. J. Higham, "Accelerating the solution of linear systems
+//   by iterative refinement in three precisions", SIAM J. Sci. Comput.,
+//   40(2), 2018.
+//
+// The matrix is factored in the demoted precision (e.g., single rather than
+// double), which roughly halves the cost of the dominant O(n^3) work, and
+// each correction equation A d = r is solved in the working precision by
+// FGMRES preconditioned with the demoted factorization. Unlike classical
+// refinement, whose corrections are computed with the demoted factors alone,
+// this converges for condition numbers up to roughly the reciprocal of the
+// working precision. Residuals are computed in the working precision, which
+// yields a normwise backward stable solution.
+
+namespace El {
+
+namespace mixed_precision {
+
+// Whether every column satisfies
+//   || r ||_2 <= relTol (|| A ||_F || x ||_2 + || b ||_2);
+// non-finite residuals are reported through 'finite'
+template<typename Real>
+bool Converged
+( const Matrix<Real>& residNorms,
+  const Matrix<Real>& xNorms,
+  const Matrix<Real>& bNorms,
+        Real ANorm,
+        Real relTol,
+        bool& finite )
+{
+    EL_DEBUG_CSE
+    bool converged = true;
+    finite = true;
+    for( Int j=0; j<residNorms.Height(); ++j )
+    {
+        if( !limits::IsFinite(residNorms(j)) )
+        {
+            finite = false;
+            return false;
+        }
+        if( residNorms(j) > relTol*(ANorm*xNorms(j)+bNorms(j)) )
+            converged = false;
+    }
+    return converged;
+}
+
+// Whether the entries of a matrix with the given max norm are representable
+// in the demoted precision
+template<typename Field>
+bool Representable( Base<Field> maxNorm )
+{
+    typedef Base<Demote<Field>> LowReal;
+    return maxNorm < Base<Field>(limits::Max<LowReal>());
+}
+
+// In what follows, 'applyA' should be a function of the form
+//
+//   void applyA
+//   ( Field alpha, const Matrix<Field>& X, Field beta, Matrix<Field>& Y )
+//
+// and overwrite Y := alpha A X + beta Y, whereas 'applyFactInv' should have
+// the form
+//
+//   void applyFactInv( Matrix<Field>& B )
+//
+// and overwrite B with the solution of the demoted factorization against B.
+//
+// Returns true if X converged, and false if the refinement stagnated or
+// produced non-finite values.
+template<typename Field,class ApplyAType,class ApplyFactInvType>
+bool Refine
+( const ApplyAType& applyA,
+  const ApplyFactInvType& applyFactInv,
+        Base<Field> ANorm,
+  const Matrix<Field>& B,
+        Matrix<Field>& X,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl,
+        MixedPrecisionInfo& info )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    Matrix<Real> bNorms, xNorms, residNorms;
+    ColumnTwoNorms( B, bNorms );
+
+    X = B;
+    applyFactInv( X );
+    Matrix<Field> R;
+    while( true )
+    {
+        // R := B - A X
+        R = B;
+        applyA( Field(-1), X, Field(1), R );
+        ColumnTwoNorms( R, residNorms );
+        ColumnTwoNorms( X, xNorms );
+        bool finite;
+        const bool converged =
+          Converged( residNorms, xNorms, bNorms, ANorm, ctrl.relTol, finite );
+        if( ctrl.progress )
+            Output
+            ("refinement step ",info.numRefineIts,": max residual norm of ",
+             MaxNorm(residNorms));
+        if( converged )
+            return true;
+        if( !finite || info.numRefineIts == ctrl.maxRefineIts )
+            return false;
+
+        // Solve A D = R in place using preconditioned FGMRES
+        try
+        {
+            info.numInnerIts +=
+              FGMRES
+              ( applyA, applyFactInv, R, ctrl.innerRelTol, ctrl.restart,
+                ctrl.maxInnerIts, ctrl.progress );
+        }
+        catch( const std::exception& except )
+        {
+            if( ctrl.progress )
+                Output("FGMRES failed: ",except.what());
+            return false;
+        }
+        Axpy( Field(1), R, X );
+        ++info.numRefineIts;
+    }
+}
+
+// The same as above, but with 'applyA' and 'applyFactInv' acting upon
+// [MC,MR] matrices. The correction equations are solved by the DistMultiVec
+// implementation of FGMRES.
+template<typename Field,class ApplyAType,class ApplyFactInvType>
+bool Refine
+( const ApplyAType& applyA,
+  const ApplyFactInvType& applyFactInv,
+        Base<Field> ANorm,
+  const DistMatrix<Field>& B,
+        DistMatrix<Field>& X,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl,
+        MixedPrecisionInfo& info )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = B.Grid();
+
+    auto applyAMultiVec =
+      [&]( Field alpha, const DistMultiVec<Field>& x,
+           Field beta,        DistMultiVec<Field>& y )
+      {
+          DistMatrix<Field> xDist(g), yDist(g);
+          Copy( x, xDist );
+          Copy( y, yDist );
+          applyA( alpha, xDist, beta, yDist );
+          Copy( yDist, y );
+      };
+    auto applyFactInvMultiVec =
+      [&]( DistMultiVec<Field>& b )
+      {
+          DistMatrix<Field> bDist(g);
+          Copy( b, bDist );
+          applyFactInv( bDist );
+          Copy( bDist, b );
+      };
+
+    DistMatrix<Real,MR,STAR> normsDist(g);
+    DistMatrix<Real,STAR,STAR> bNorms(g), xNorms(g), residNorms(g);
+    ColumnTwoNorms( B, normsDist );
+    bNorms = normsDist;
+
+    X = B;
+    applyFactInv( X );
+    DistMatrix<Field> R(g);
+    DistMultiVec<Field> D(g);
+    while( true )
+    {
+        // R := B - A X
+        R = B;
+        applyA( Field(-1), X, Field(1), R );
+        ColumnTwoNorms( R, normsDist );
+        residNorms = normsDist;
+        ColumnTwoNorms( X, normsDist );
+        xNorms = normsDist;
+        bool finite;
+        const bool converged =
+          Converged
+          ( residNorms.Matrix(), xNorms.Matrix(), bNorms.Matrix(), ANorm,
+            ctrl.relTol, finite );
+        if( ctrl.progress && g.Rank() == 0 )
+            Output
+            ("refinement step ",info.numRefineIts,": max residual norm of ",
+             MaxNorm(residNorms.Matrix()));
+        if( converged )
+            return true;
+        if( !finite || info.numRefineIts == ctrl.maxRefineIts )
+            return false;
+
+        // Solve A D = R using preconditioned FGMRES
+        Copy( R, D );
+        try
+        {
+            info.numInnerIts +=
+              FGMRES
+              ( applyAMultiVec, applyFactInvMultiVec, D, ctrl.innerRelTol,
+                ctrl.restart, ctrl.maxInnerIts, ctrl.progress );
+        }
+        catch( const std::exception& except )
+        {
+            if( ctrl.progress && g.Rank() == 0 )
+                Output("FGMRES failed: ",except.what());
+            return false;
+        }
+        Copy( D, R );
+        Axpy( Field(1), R, X );
+        ++info.numRefineIts;
+    }
+}
+
+} // namespace mixed_precision
+
+// General
+// =======
+
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionLinearSolve
+( const Matrix<Field>& A,
+        Matrix<Field>& B,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Demote<Field> LowField;
+    MixedPrecisionInfo info;
+    bool converged = false;
+    if( mixed_precision::Representable<Field>( MaxNorm(A) ) )
+    {
+        Matrix<LowField> ALow;
+        Copy( A, ALow );
+        Permutation P;
+        LU( ALow, P );
+
+        auto applyA =
+          [&]( Field alpha, const Matrix<Field>& X,
+               Field beta,        Matrix<Field>& Y )
+          { Gemm( NORMAL, NORMAL, alpha, A, X, beta, Y ); };
+        auto applyFactInv =
+          [&]( Matrix<Field>& X )
+          {
+              Matrix<LowField> XLow;
+              Copy( X, XLow );
+              lu::SolveAfter( NORMAL, ALow, P, XLow );
+              Copy( XLow, X );
+          };
+        Matrix<Field> X;
+        converged =
+          mixed_precision::Refine
+          ( applyA, applyFactInv, FrobeniusNorm(A), B, X, ctrl, info );
+        if( converged )
+            B = X;
+    }
+    if( !converged )
+    {
+        if( !ctrl.fallback )
+            RuntimeError("Mixed-precision refinement did not converge");
+        info.fellBack = true;
+        LinearSolve( A, B );
+    }
+    return info;
+}
+
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionLinearSolve
+( const AbstractDistMatrix<Field>& APre,
+        AbstractDistMatrix<Field>& BPre,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Demote<Field> LowField;
+    DistMatrixReadProxy<Field,Field,MC,MR> AProx( APre );
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> BProx( BPre );
+    auto& A = AProx.GetLocked();
+    auto& B = BProx.Get();
+    const Grid& g = A.Grid();
+
+    MixedPrecisionInfo info;
+    bool converged = false;
+    if( mixed_precision::Representable<Field>( MaxNorm(A) ) )
+    {
+        DistMatrix<LowField> ALow(g);
+        Copy( A, ALow );
+        DistPermutation P(g);
+        LU( ALow, P );
+
+        auto applyA =
+          [&]( Field alpha, const DistMatrix<Field>& X,
+               Field beta,        DistMatrix<Field>& Y )
+          { Gemm( NORMAL, NORMAL, alpha, A, X, beta, Y ); };
+        auto applyFactInv =
+          [&]( DistMatrix<Field>& X )
+          {
+              DistMatrix<LowField> XLow(g);
+              Copy( X, XLow );
+              lu::SolveAfter( NORMAL, ALow, P, XLow );
+              Copy( XLow, X );
+          };
+        DistMatrix<Field> X(g);
+        converged =
+          mixed_precision::Refine
+          ( applyA, applyFactInv, FrobeniusNorm(A), B, X, ctrl, info );
+        if( converged )
+            B = X;
+    }
+    if( !converged )
+    {
+        if( !ctrl.fallback )
+            RuntimeError("Mixed-precision refinement did not converge");
+        info.fellBack = true;
+        LinearSolve( A, B );
+    }
+    return info;
+}
+
+// Hermitian Positive-Definite
+// ===========================
+// Since A^T = conj(A), solving A^T X = B is equivalent to solving
+// A conj(X) = conj(B).
+
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionHPDSolve
+( UpperOrLower uplo,
+  Orientation orientation,
+  const Matrix<Field>& A,
+        Matrix<Field>& B,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Demote<Field> LowField;
+    if( orientation == TRANSPOSE )
+        Conjugate( B );
+
+    MixedPrecisionInfo info;
+    bool converged = false;
+    if( mixed_precision::Representable<Field>( HermitianMaxNorm(uplo,A) ) )
+    {
+        Matrix<LowField> ALow;
+        Copy( A, ALow );
+        bool factored = true;
+        try
+        {
+            Cholesky( uplo, ALow );
+        }
+        catch( const NonHPDMatrixException& )
+        {
+            factored = false;
+        }
+
+        if( factored )
+        {
+            auto applyA =
+              [&]( Field alpha, const Matrix<Field>& X,
+                   Field beta,        Matrix<Field>& Y )
+              { Hemm( LEFT, uplo, alpha, A, X, beta, Y ); };
+            auto applyFactInv =
+              [&]( Matrix<Field>& X )
+              {
+                  Matrix<LowField> XLow;
+                  Copy( X, XLow );
+                  cholesky::SolveAfter( uplo, NORMAL, ALow, XLow );
+                  Copy( XLow, X );
+              };
+            Matrix<Field> X;
+            converged =
+              mixed_precision::Refine
+              ( applyA, applyFactInv, HermitianFrobeniusNorm(uplo,A), B, X,
+                ctrl, info );
+            if( converged )
+                B = X;
+        }
+    }
+    if( !converged )
+    {
+        if( !ctrl.fallback )
+            RuntimeError("Mixed-precision refinement did not converge");
+        info.fellBack = true;
+        HPDSolve( uplo, NORMAL, A, B );
+    }
+
+    if( orientation == TRANSPOSE )
+        Conjugate( B );
+    return info;
+}
+
+template<typename Field>
+MixedPrecisionInfo MixedPrecisionHPDSolve
+( UpperOrLower uplo,
+  Orientation orientation,
+  const AbstractDistMatrix<Field>& APre,
+        AbstractDistMatrix<Field>& BPre,
+  const MixedPrecisionCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Demote<Field> LowField;
+    DistMatrixReadProxy<Field,Field,MC,MR> AProx( APre );
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> BProx( BPre );
+    auto& A = AProx.GetLocked();
+    auto& B = BProx.Get();
+    const Grid& g = A.Grid();
+    if( orientation == TRANSPOSE )
+        Conjugate( B );
+
+    MixedPrecisionInfo info;
+    bool converged = false;
+    if( mixed_precision::Representable<Field>( HermitianMaxNorm(uplo,A) ) )
+    {
+        DistMatrix<LowField> ALow(g);
+        Copy( A, ALow );
+        bool factored = true;
+        try
+        {
+            Cholesky( uplo, ALow );
+        }
+        catch( const NonHPDMatrixException& )
+        {
+            factored = false;
+        }
+
+        if( factored )
+        {
+            auto applyA =
+              [&]( Field alpha, const DistMatrix<Field>& X,
+                   Field beta,        DistMatrix<Field>& Y )
+              { Hemm( LEFT, uplo, alpha, A, X, beta, Y ); };
+            auto applyFactInv =
+              [&]( DistMatrix<Field>& X )
+              {
+                  DistMatrix<LowField> XLow(g);
+                  Copy( X, XLow );
+                  cholesky::SolveAfter( uplo, NORMAL, ALow, XLow );
+                  Copy( XLow, X );
+              };
+            DistMatrix<Field> X(g);
+            converged =
+              mixed_precision::Refine
+              ( applyA, applyFactInv, HermitianFrobeniusNorm(uplo,A), B, X,
+                ctrl, info );
+            if( converged )
+                B = X;
+        }
+    }
+    if( !converged )
+    {
+        if( !ctrl.fallback )
+            RuntimeError("Mixed-precision refinement did not converge");
+        info.fellBack = true;
+        HPDSolve( uplo, NORMAL, A, B );
+    }
+
+    if( orientation == TRANSPOSE )
+        Conjugate( B );
+    return info;
+}
+
+} // namespace El
+
+#endif // ifndef EL_SOLVE_MIXED_PRECISION_HPP
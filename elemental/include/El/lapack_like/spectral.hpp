@@ -460,8 +460,97 @@ HermitianEig
         AbstractDistMatrix<Field>& Q,
   const HermitianEigCtrl<Field>& ctrl=HermitianEigCtrl<Field>() );
 
+// Compute eigenpairs via spectrum slicing
+// ---------------------------------------
+// After the reduction to tridiagonal form, the requested eigenvalues (see
+// tridiagEigCtrl.subset) are split into 'numSlices' slices of nearly equal
+// size whose boundaries are moved to the largest nearby gaps in the
+// spectrum. The process grid is then split into one subgrid per slice, and
+// the eigenpairs of each slice are computed independently via
+// HermitianTridiagEig on its subgrid. Only the eigenvectors of clusters which
+// could not be kept within a single slice are reorthogonalized.
+template<typename Field>
+struct HermitianEigSlicingCtrl
+{
+    HermitianEigCtrl<Field> eigCtrl;
+
+    // Reduce to tridiagonal form in two stages, through a band matrix of
+    // width 'twoStageBandwidth' (or Blocksize() if it is zero)
+    bool useTwoStage=false;
+    Int twoStageBandwidth=0;
+
+    // If zero, one slice per process column is used
+    Int numSlices=0;
+
+    // The number of eigenvalues on each side of a nominal slice boundary
+    // which are searched for the largest gap
+    Int searchWidth=8;
+
+    // Eigenvalues separated by less than relGapTol ||T||_2 are treated as a
+    // cluster (cf. LAPACK's {s,d}larrv)
+    Base<Field> relGapTol=Base<Field>(1e-3);
+
+    bool progress=false;
+};
+
+template<typename Field>
+HermitianEigInfo
+HermitianEigSliced
+(       UpperOrLower uplo,
+        AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Base<Field>>& w,
+        AbstractDistMatrix<Field>& Q,
+  const HermitianEigSlicingCtrl<Field>& ctrl=
+        HermitianEigSlicingCtrl<Field>() );
+
+// Hermitian eigensolvers using the two-stage reduction to tridiagonal form
+// (cf. herm_tridiag::TwoStage) through a band matrix of width 'bandwidth'
+// (or Blocksize() if it is zero)
+template<typename Field>
+struct HermitianEigTwoStageCtrl
+{
+    HermitianTridiagEigCtrl<Base<Field>> tridiagEigCtrl;
+    Int bandwidth=0;
+    bool timeStages=false;
+};
+
 namespace herm_eig {
 
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        Matrix<Field>& A,
+        Matrix<Base<Field>>& w,
+  const HermitianEigTwoStageCtrl<Field>& ctrl=
+        HermitianEigTwoStageCtrl<Field>() );
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Base<Field>>& w,
+  const HermitianEigTwoStageCtrl<Field>& ctrl=
+        HermitianEigTwoStageCtrl<Field>() );
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        Matrix<Field>& A,
+        Matrix<Base<Field>>& w,
+        Matrix<Field>& Q,
+  const HermitianEigTwoStageCtrl<Field>& ctrl=
+        HermitianEigTwoStageCtrl<Field>() );
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Base<Field>>& w,
+        AbstractDistMatrix<Field>& Q,
+  const HermitianEigTwoStageCtrl<Field>& ctrl=
+        HermitianEigTwoStageCtrl<Field>() );
+
 template<typename Real,
          typename=EnableIf<IsReal<Real>>>
 void TwoByTwo
@@ -646,6 +735,96 @@ PolarInfo HermitianPolar
   AbstractDistMatrix<Field>& P,
   const PolarCtrl& ctrl=PolarCtrl() );
 
+// QDWH and Zolo-PD with Cholesky-based iterations
+// ------------------------------------------------
+// The QDWH behind Polar (with PolarCtrl::qdwh) also switches from QR-based
+// to Cholesky-based iterations, but at a fixed point (once its weight c is
+// at most 100) and without reporting where the time was spent. CholQDWH is
+// instead the single-term case of the Zolo-PD iteration below and shares
+// its implementation: each term is formed from the Cholesky factor of the
+// shifted Gram matrix once that matrix's condition number is guaranteed to
+// be at most 'cholThreshold' (which may be tuned, or the switch disabled),
+// the Gram matrix is formed once per iterate, and the time spent in each
+// kind of factorization is reported. Its results may therefore be compared
+// term-for-term with those of Zolo-PD.
+struct CholQDWHCtrl
+{
+    bool colPiv=false;
+    Int maxIts=20;
+    bool cholesky=true;
+    double cholThreshold=100;
+};
+
+// For Zolo-PD, numQRIts and numCholIts count the factorizations of each of
+// the terms of every iteration (over all subgrids). In the distributed case,
+// the times (in seconds) are the maxima over the processes, and, when the
+// terms are formed on subgrids, the factorization times of each iteration
+// are those of the slowest subgrid.
+struct CholQDWHInfo
+{
+    Int numIts=0;
+    Int numQRIts=0;
+    Int numCholIts=0;
+
+    double estimateTime=0;
+    double qrTime=0;
+    double cholTime=0;
+    double totalTime=0;
+};
+
+struct ZoloPDCtrl
+{
+    // The number of terms, r, of the Zolotarev functions, where zero selects
+    // the smallest r <= 8 which converges within two iterations
+    Int numTerms=0;
+    // Form the terms in parallel on Min(p,r) subgrids of the p processes
+    bool subgrids=true;
+    CholQDWHCtrl qdwhCtrl;
+};
+
+namespace polar {
+
+// Overwrite A with its polar factor using QDWH, and optionally return the
+// Hermitian positive semi-definite factor P = U^H A. When A is Hermitian,
+// its polar factor is its matrix sign function.
+template<typename Field>
+CholQDWHInfo CholQDWH
+( Matrix<Field>& A, const CholQDWHCtrl& ctrl=CholQDWHCtrl() );
+template<typename Field>
+CholQDWHInfo CholQDWH
+( AbstractDistMatrix<Field>& A, const CholQDWHCtrl& ctrl=CholQDWHCtrl() );
+template<typename Field>
+CholQDWHInfo CholQDWH
+( Matrix<Field>& A,
+  Matrix<Field>& P,
+  const CholQDWHCtrl& ctrl=CholQDWHCtrl() );
+template<typename Field>
+CholQDWHInfo CholQDWH
+( AbstractDistMatrix<Field>& A,
+  AbstractDistMatrix<Field>& P,
+  const CholQDWHCtrl& ctrl=CholQDWHCtrl() );
+
+// Overwrite A with its polar factor using Zolo-PD, and optionally return
+// P = U^H A
+template<typename Field>
+CholQDWHInfo ZoloPD
+( Matrix<Field>& A, const ZoloPDCtrl& ctrl=ZoloPDCtrl() );
+template<typename Field>
+CholQDWHInfo ZoloPD
+( AbstractDistMatrix<Field>& A, const ZoloPDCtrl& ctrl=ZoloPDCtrl() );
+template<typename Field>
+CholQDWHInfo ZoloPD
+( Matrix<Field>& A,
+  Matrix<Field>& P,
+  const ZoloPDCtrl& ctrl=ZoloPDCtrl() );
+template<typename Field>
+CholQDWHInfo ZoloPD
+( AbstractDistMatrix<Field>& A,
+  AbstractDistMatrix<Field>& P,
+  const ZoloPDCtrl& ctrl=ZoloPDCtrl() );
+
+} // namespace polar
+
 // Hessenberg Schur decomposition
 // ==============================
 struct HessenbergSchurInfo
@@ -1357,6 +1536,68 @@ SVDInfo TSQR
 
 } // namespace svd
 
+// Batched SVD
+// ===========
+// Thin SVDs of batches of small matrices, stored as for BatchedCholesky and
+// BatchedQR. Matrices with at most batched::maxFixedWidth columns (and at
+// least as many rows) use a one-sided Jacobi method whose loop bounds are
+// compile-time constants; the remainder use SVD. Each A_k is overwritten.
+//
+// The singular values of A_k are stored in the k'th min(m,n)-length segment
+// of s (or in its column k), and the singular vectors are stored in batches
+// of m x min(m,n) and n x min(m,n) matrices.
+
+template<typename Field>
+void BatchedSVD
+( Int m,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Base<Field>* s );
+template<typename Field>
+void BatchedSVD
+( Int m,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Field* U,
+  Int ldimU,
+  Int strideU,
+  Base<Field>* s,
+  Field* V,
+  Int ldimV,
+  Int strideV );
+
+template<typename Field>
+void BatchedSVD
+( Int n,
+  Matrix<Field>& A,
+  Matrix<Base<Field>>& s );
+template<typename Field>
+void BatchedSVD
+( Int n,
+  Matrix<Field>& A,
+  Matrix<Field>& U,
+  Matrix<Base<Field>>& s,
+  Matrix<Field>& V );
+
+template<typename Field>
+void BatchedSVD
+( Int n,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Base<Field>,STAR,VC,BLOCK>& s );
+template<typename Field>
+void BatchedSVD
+( Int n,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Field,STAR,VC,BLOCK>& U,
+  DistMatrix<Base<Field>,STAR,VC,BLOCK>& s,
+  DistMatrix<Field,STAR,VC,BLOCK>& V );
+
 // Hermitian SVD
 // =============
 
@@ -1549,6 +1790,182 @@ pair<Base<Field>,Base<Field>>
 HermitianExtremalSingValEst
 ( const DistSparseMatrix<Field>& A, Int basisSize=20 );
 
+// Thick-restart block Lanczos
+// ===========================
+// Compute the numEig largest eigenpairs of an (explicitly) Hermitian matrix,
+// or the numVals dominant singular triplets of a general matrix, using a
+// restarted block Krylov method whose bases are distributed by rows.
+// Unlike Lanczos and ProductLanczos, the basis is fully reorthogonalized,
+// restarted until the Ritz pairs converge, and used to form Ritz vectors.
+
+template<typename Real>
+struct BlockLanczosCtrl
+{
+    Int blockSize=4;
+    // The maximum number of basis vectors (excluding the residual block);
+    // if nonpositive, max(2 numEig, numEig + 3 blockSize) is used
+    Int basisSize=0;
+    Int maxRestarts=100;
+    // A Ritz pair (theta,x) is accepted once || A x - x theta ||_2 is at most
+    // tol times the largest Ritz value in magnitude; if nonpositive, the
+    // square-root of machine epsilon is used
+    Real tol=Real(0);
+    bool progress=false;
+};
+
+struct BlockLanczosInfo
+{
+    Int numRestarts=0;
+    // The number of applications of the operator to a block
+    Int numApplications=0;
+    Int numConverged=0;
+};
+
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const Matrix<Field>& A,
+        Int numEig,
+        Matrix<Base<Field>>& w,
+        Matrix<Field>& X,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const AbstractDistMatrix<Field>& A,
+        Int numEig,
+        AbstractDistMatrix<Base<Field>>& w,
+        AbstractDistMatrix<Field>& X,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const SparseMatrix<Field>& A,
+        Int numEig,
+        Matrix<Base<Field>>& w,
+        Matrix<Field>& X,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const DistSparseMatrix<Field>& A,
+        Int numEig,
+        Matrix<Base<Field>>& w,
+        DistMultiVec<Field>& X,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const Matrix<Field>& A,
+        Int numVals,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& s,
+        Matrix<Field>& V,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const AbstractDistMatrix<Field>& A,
+        Int numVals,
+        AbstractDistMatrix<Field>& U,
+        AbstractDistMatrix<Base<Field>>& s,
+        AbstractDistMatrix<Field>& V,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const SparseMatrix<Field>& A,
+        Int numVals,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& s,
+        Matrix<Field>& V,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const DistSparseMatrix<Field>& A,
+        Int numVals,
+        DistMultiVec<Field>& U,
+        Matrix<Base<Field>>& s,
+        DistMultiVec<Field>& V,
+  const BlockLanczosCtrl<Base<Field>>& ctrl=BlockLanczosCtrl<Base<Field>>() );
+
+// Randomized low-rank approximation
+// =================================
+// Cf.
+//
+//   N. Halko, P.-G. Martinsson, and J. A. Tropp, "Finding structure with
+//   randomness: Probabilistic algorithms for constructing approximate matrix
+//   decompositions", SIAM Review, 53(2), 2011.
+//
+// The test matrices are drawn with a counter-based generator, so that the
+// results do not depend upon the process grid.
+
+namespace SketchTypeNS {
+enum SketchType
+{
+    GAUSSIAN_SKETCH, // i.i.d. standard normal entries
+    SRHT_SKETCH,     // subsampled randomized Hadamard transform
+    COUNT_SKETCH     // a single random sign in each row
+};
+}
+using namespace SketchTypeNS;
+
+struct RandomizedCtrl
+{
+    SketchType sketch=GAUSSIAN_SKETCH;
+    // The number of sketch columns beyond the requested rank
+    Int oversample=10;
+    Int numPowerIts=1;
+    // If zero, a seed is drawn from the default generator on the root
+    std::uint64_t seed=0;
+};
+
+// Return an orthonormal basis for the approximate range of A, with
+// min(rank+oversample,min(m,n)) columns
+template<typename Field>
+void RandomizedRangeFinder
+( const Matrix<Field>& A,
+        Int rank,
+        Matrix<Field>& Q,
+  const RandomizedCtrl& ctrl=RandomizedCtrl() );
+template<typename Field>
+void RandomizedRangeFinder
+( const AbstractDistMatrix<Field>& A,
+        Int rank,
+        AbstractDistMatrix<Field>& Q,
+  const RandomizedCtrl& ctrl=RandomizedCtrl() );
+
+// Return an approximation of the 'rank' dominant singular triplets of A
+template<typename Field>
+void RandomizedSVD
+( const Matrix<Field>& A,
+        Int rank,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& s,
+        Matrix<Field>& V,
+  const RandomizedCtrl& ctrl=RandomizedCtrl() );
+template<typename Field>
+void RandomizedSVD
+( const AbstractDistMatrix<Field>& A,
+        Int rank,
+        AbstractDistMatrix<Field>& U,
+        AbstractDistMatrix<Base<Field>>& s,
+        AbstractDistMatrix<Field>& V,
+  const RandomizedCtrl& ctrl=RandomizedCtrl() );
+
+// Return a rank-'rank' approximation A ~= U diag(w) U' of a Hermitian
+// positive semi-definite matrix (with nonincreasing w)
+template<typename Field>
+void NystromHermitianApprox
+(       UpperOrLower uplo,
+  const Matrix<Field>& A,
+        Int rank,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& w,
+  const RandomizedCtrl& ctrl=RandomizedCtrl() );
+template<typename Field>
+void NystromHermitianApprox
+(       UpperOrLower uplo,
+  const AbstractDistMatrix<Field>& A,
+        Int rank,
+        AbstractDistMatrix<Field>& U,
+        AbstractDistMatrix<Base<Field>>& w,
+  const RandomizedCtrl& ctrl=RandomizedCtrl() );
+
 // Pseudospectra
 // =============
 enum PseudospecNorm {
@@ -2011,8 +2428,13 @@ DistMatrix<Int,VR,STAR> HessenbergSpectralCloud
 
 #include <El/lapack_like/spectral/Schur.hpp>
 #include <El/lapack_like/spectral/HermitianEig.hpp>
+#include <El/lapack_like/spectral/SpectrumSlicing.hpp>
+#include <El/lapack_like/spectral/QDWH.hpp>
 #include <El/lapack_like/spectral/SVD.hpp>
+#include <El/lapack_like/spectral/Batched.hpp>
 #include <El/lapack_like/spectral/Lanczos.hpp>
 #include <El/lapack_like/spectral/ProductLanczos.hpp>
+#include <El/lapack_like/spectral/BlockLanczos.hpp>
+#include <El/lapack_like/spectral/Randomized.hpp>
 
 #endif // ifndef EL_SPECTRAL_HPP
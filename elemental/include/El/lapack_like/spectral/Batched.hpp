@@ -0,0 +1,351 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_SPECTRAL_BATCHED_HPP
+#define EL_SPECTRAL_BATCHED_HPP
+
+namespace El {
+namespace batched {
+
+// One-sided (Hestenes) Jacobi SVD of an m x N matrix with m >= N: pairs of
+// columns of A are rotated until they are numerically orthogonal, at which
+// point A = U diag(s) and the accumulated rotations form V. Each sweep
+// requires O(m N^2) work, and a handful of sweeps typically suffice.
+//
+// Upon return, s contains the singular values in non-increasing order and,
+// if 'vectors' is true, the first N columns of U and V hold the
+// corresponding left and right singular vectors. A is overwritten.
+template<Int N,typename Field>
+void FixedJacobiSVD
+( Int m,
+  Field* A,
+  Int ldim,
+  Base<Field>* s,
+  bool vectors,
+  Field* U,
+  Int ldimU,
+  Field* V,
+  Int ldimV )
+{
+    typedef Base<Field> Real;
+    const Real eps = limits::Epsilon<Real>();
+    const Real tol = Max(Real(m),Real(1))*eps;
+    const Int maxSweeps = 30;
+
+    Field W[N*N];
+    for( Int j=0; j<N; ++j )
+        for( Int i=0; i<N; ++i )
+            W[i+j*N] = ( i == j ? Field(1) : Field(0) );
+
+    for( Int sweep=0; sweep<maxSweeps; ++sweep )
+    {
+        bool rotated = false;
+        for( Int p=0; p<N-1; ++p )
+        {
+            for( Int q=p+1; q<N; ++q )
+            {
+                Real alpha=0, beta=0;
+                Field gamma=0;
+                for( Int i=0; i<m; ++i )
+                {
+                    alpha += RealPart(Conj(A[i+p*ldim])*A[i+p*ldim]);
+                    beta += RealPart(Conj(A[i+q*ldim])*A[i+q*ldim]);
+                    gamma += Conj(A[i+p*ldim])*A[i+q*ldim];
+                }
+                const Real gammaAbs = Abs(gamma);
+                if( gammaAbs == Real(0) || gammaAbs <= tol*Sqrt(alpha*beta) )
+                    continue;
+                rotated = true;
+
+                // Scale column q by a unit phase so that the inner product
+                // of columns p and q is real and then apply a real rotation
+                const Field phase = Conj(gamma) / gammaAbs;
+                const Real zeta = (beta-alpha) / (2*gammaAbs);
+                const Real t = (zeta >= Real(0) ? Real(1) : Real(-1)) /
+                               (Abs(zeta)+Sqrt(1+zeta*zeta));
+                const Real c = 1/Sqrt(1+t*t);
+                const Real sn = c*t;
+                for( Int i=0; i<m; ++i )
+                {
+                    const Field chi = A[i+p*ldim];
+                    const Field eta = A[i+q*ldim]*phase;
+                    A[i+p*ldim] = c*chi - sn*eta;
+                    A[i+q*ldim] = sn*chi + c*eta;
+                }
+                for( Int i=0; i<N; ++i )
+                {
+                    const Field chi = W[i+p*N];
+                    const Field eta = W[i+q*N]*phase;
+                    W[i+p*N] = c*chi - sn*eta;
+                    W[i+q*N] = sn*chi + c*eta;
+                }
+            }
+        }
+        if( !rotated )
+            break;
+    }
+
+    // Sort the column norms into non-increasing order
+    Real norms[N];
+    Int order[N];
+    for( Int j=0; j<N; ++j )
+    {
+        Real normSquared = 0;
+        for( Int i=0; i<m; ++i )
+            normSquared += RealPart(Conj(A[i+j*ldim])*A[i+j*ldim]);
+        norms[j] = Sqrt(normSquared);
+        order[j] = j;
+    }
+    for( Int j=0; j<N; ++j )
+    {
+        Int jMax = j;
+        for( Int k=j+1; k<N; ++k )
+            if( norms[order[k]] > norms[order[jMax]] )
+                jMax = k;
+        std::swap( order[j], order[jMax] );
+        s[j] = norms[order[j]];
+    }
+    if( !vectors )
+        return;
+
+    for( Int j=0; j<N; ++j )
+    {
+        const Int jOrig = order[j];
+        for( Int i=0; i<N; ++i )
+            V[i+j*ldimV] = W[i+jOrig*N];
+        if( s[j] > Real(0) )
+        {
+            for( Int i=0; i<m; ++i )
+                U[i+j*ldimU] = A[i+jOrig*ldim] / s[j];
+            continue;
+        }
+
+        // Complete the left singular vectors of the (trailing) zero singular
+        // values by orthogonalizing standard basis vectors
+        for( Int e=0; e<m; ++e )
+        {
+            for( Int i=0; i<m; ++i )
+                U[i+j*ldimU] = ( i == e ? Field(1) : Field(0) );
+            for( Int pass=0; pass<2; ++pass )
+            {
+                for( Int k=0; k<j; ++k )
+                {
+                    Field dot = 0;
+                    for( Int i=0; i<m; ++i )
+                        dot += Conj(U[i+k*ldimU])*U[i+j*ldimU];
+                    for( Int i=0; i<m; ++i )
+                        U[i+j*ldimU] -= dot*U[i+k*ldimU];
+                }
+            }
+            Real normSquared = 0;
+            for( Int i=0; i<m; ++i )
+                normSquared += RealPart(Conj(U[i+j*ldimU])*U[i+j*ldimU]);
+            if( normSquared > Real(1)/Real(4) )
+            {
+                const Real norm = Sqrt(normSquared);
+                for( Int i=0; i<m; ++i )
+                    U[i+j*ldimU] /= norm;
+                break;
+            }
+        }
+    }
+}
+
+// Compute the (thin) SVD of an m x n matrix, overwriting A
+template<typename Field>
+void SVD
+( Int m,
+  Int n,
+  Field* A,
+  Int ldim,
+  Base<Field>* s,
+  bool vectors,
+  Field* U,
+  Int ldimU,
+  Field* V,
+  Int ldimV )
+{
+    typedef Base<Field> Real;
+    if( m >= n )
+    {
+        switch( n )
+        {
+        case 0: return;
+#define EL_BATCHED_JACOBI(N) \
+        case N: \
+            FixedJacobiSVD<N>( m, A, ldim, s, vectors, U, ldimU, V, ldimV ); \
+            return;
+        EL_BATCHED_JACOBI(1)
+        EL_BATCHED_JACOBI(2)
+        EL_BATCHED_JACOBI(3)
+        EL_BATCHED_JACOBI(4)
+        EL_BATCHED_JACOBI(5)
+        EL_BATCHED_JACOBI(6)
+        EL_BATCHED_JACOBI(7)
+        EL_BATCHED_JACOBI(8)
+#undef EL_BATCHED_JACOBI
+        default: break;
+        }
+    }
+
+    const Int minDim = Min(m,n);
+    Matrix<Field> AView;
+    AView.Attach( m, n, A, ldim );
+    Matrix<Real> sView;
+    sView.Attach( minDim, 1, s, Max(minDim,Int(1)) );
+    SVDCtrl<Real> ctrl;
+    ctrl.overwrite = true;
+    if( vectors )
+    {
+        Matrix<Field> UView, VView;
+        UView.Attach( m, minDim, U, ldimU );
+        VView.Attach( n, minDim, V, ldimV );
+        Matrix<Field> UTmp, VTmp;
+        Matrix<Real> sTmp;
+        El::SVD( AView, UTmp, sTmp, VTmp, ctrl );
+        UView = UTmp;
+        sView = sTmp;
+        VView = VTmp;
+    }
+    else
+    {
+        Matrix<Real> sTmp;
+        El::SVD( AView, sTmp, ctrl );
+        sView = sTmp;
+    }
+}
+
+} // namespace batched
+
+// Batched SVD
+// ===========
+template<typename Field>
+void BatchedSVD
+( Int m,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Base<Field>* s )
+{
+    EL_DEBUG_CSE
+    const Int minDim = Min(m,n);
+    batched::ForEach
+    ( batchSize,
+      [&]( Int k )
+      {
+          batched::SVD
+          ( m, n, &A[k*stride], ldim, &s[k*minDim],
+            false, (Field*)nullptr, 1, (Field*)nullptr, 1 );
+      } );
+}
+
+template<typename Field>
+void BatchedSVD
+( Int m,
+  Int n,
+  Int batchSize,
+  Field* A,
+  Int ldim,
+  Int stride,
+  Field* U,
+  Int ldimU,
+  Int strideU,
+  Base<Field>* s,
+  Field* V,
+  Int ldimV,
+  Int strideV )
+{
+    EL_DEBUG_CSE
+    const Int minDim = Min(m,n);
+    batched::ForEach
+    ( batchSize,
+      [&]( Int k )
+      {
+          batched::SVD
+          ( m, n, &A[k*stride], ldim, &s[k*minDim],
+            true, &U[k*strideU], ldimU, &V[k*strideV], ldimV );
+      } );
+}
+
+template<typename Field>
+void BatchedSVD
+( Int n,
+  Matrix<Field>& A,
+  Matrix<Base<Field>>& s )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int minDim = Min(m,n);
+    if( n <= 0 || A.Width() % n != 0 )
+        LogicError("Batch width, ",A.Width(),", was not a multiple of ",n);
+    const Int batchSize = A.Width() / n;
+    s.Resize( minDim, batchSize, Max(minDim,Int(1)) );
+    BatchedSVD
+    ( m, n, batchSize, A.Buffer(), A.LDim(), n*A.LDim(), s.Buffer() );
+}
+
+template<typename Field>
+void BatchedSVD
+( Int n,
+  Matrix<Field>& A,
+  Matrix<Field>& U,
+  Matrix<Base<Field>>& s,
+  Matrix<Field>& V )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int minDim = Min(m,n);
+    if( n <= 0 || A.Width() % n != 0 )
+        LogicError("Batch width, ",A.Width(),", was not a multiple of ",n);
+    const Int batchSize = A.Width() / n;
+    U.Resize( m, batchSize*minDim );
+    s.Resize( minDim, batchSize, Max(minDim,Int(1)) );
+    V.Resize( n, batchSize*minDim );
+    BatchedSVD
+    ( m, n, batchSize, A.Buffer(), A.LDim(), n*A.LDim(),
+      U.Buffer(), U.LDim(), minDim*U.LDim(),
+      s.Buffer(),
+      V.Buffer(), V.LDim(), minDim*V.LDim() );
+}
+
+template<typename Field>
+void BatchedSVD
+( Int n,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Base<Field>,STAR,VC,BLOCK>& s )
+{
+    EL_DEBUG_CSE
+    const Int minDim = Min(A.Height(),n);
+    batched::AssertBatch( A, n );
+    batched::BatchLike( A, n, minDim, 1, s );
+    BatchedSVD( n, A.Matrix(), s.Matrix() );
+}
+
+template<typename Field>
+void BatchedSVD
+( Int n,
+  DistMatrix<Field,STAR,VC,BLOCK>& A,
+  DistMatrix<Field,STAR,VC,BLOCK>& U,
+  DistMatrix<Base<Field>,STAR,VC,BLOCK>& s,
+  DistMatrix<Field,STAR,VC,BLOCK>& V )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int minDim = Min(m,n);
+    batched::AssertBatch( A, n );
+    batched::BatchLike( A, n, m, minDim, U );
+    batched::BatchLike( A, n, minDim, 1, s );
+    batched::BatchLike( A, n, n, minDim, V );
+    BatchedSVD( n, A.Matrix(), U.Matrix(), s.Matrix(), V.Matrix() );
+}
+
+} // namespace El
+
+#endif // ifndef EL_SPECTRAL_BATCHED_HPP
@@ -0,0 +1,591 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_SPECTRAL_BLOCKLANCZOS_HPP
+#define EL_SPECTRAL_BLOCKLANCZOS_HPP
+
+namespace El {
+
+namespace block_lanczos {
+
+// All of the routines below act upon the local rows of tall-skinny blocks
+// whose rows are distributed over 'comm' (with the local rows of each block
+// always corresponding to the same global rows). Sequential problems simply
+// use mpi::COMM_SELF.
+
+// Orthonormalize the columns of W against those of the (orthonormal) basis V
+// and each other using passes of SVQB, so that the original W equals
+// V C + W R, where C is accumulated into 'C'. At least two and at most four
+// passes are performed, stopping after the first pass (beyond the first)
+// which finds no deficient columns. Columns found to be (nearly) linearly
+// dependent upon the rest are replaced by random directions which are
+// orthogonal to V and, as they do not contribute to the original W,
+// correspond to zero rows of R. Replacements made by the last pass are
+// orthonormalized by two passes of Gram-Schmidt against V and the rest of W.
+template<typename Field>
+void Orthonormalize
+( const Matrix<Field>& V,
+        Matrix<Field>& W,
+        Matrix<Field>& C,
+        Matrix<Field>& R,
+        mpi::Comm comm )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Real eps = limits::Epsilon<Real>();
+    const Int b = W.Width();
+    const Int basisSize = V.Width();
+
+    Matrix<Field> G, U, WNew, RNew, CPass;
+    Matrix<Real> s;
+    Identity( R, b, b );
+    Zeros( C, basisSize, b );
+    const Int maxPasses = 4;
+    vector<Int> deficient;
+    for( Int pass=0; pass<maxPasses; ++pass )
+    {
+        // W := (I - V V^H) W
+        if( basisSize > 0 )
+        {
+            Gemm( ADJOINT, NORMAL, Field(1), V, W, CPass );
+            mpi::AllReduce( CPass.Buffer(), basisSize*b, comm );
+            Gemm( NORMAL, NORMAL, Field(-1), V, CPass, Field(1), W );
+            // The projection coefficients of the original W are C R
+            Gemm( NORMAL, NORMAL, Field(1), CPass, R, Field(1), C );
+        }
+
+        // W := W U diag(s)^{-1/2}, where W^H W = U diag(s) U^H
+        Gemm( ADJOINT, NORMAL, Field(1), W, W, G );
+        mpi::AllReduce( G.Buffer(), b*b, comm );
+        HermitianEig( LOWER, G, s, U );
+        const Real sMax = ( b > 0 ? s(b-1) : Real(0) );
+        const Real threshold = b*eps*sMax;
+        deficient.clear();
+        Matrix<Field> UScaled( U );
+        for( Int j=0; j<b; ++j )
+        {
+            const Real sj = s(j);
+            auto uScaled = UScaled( ALL, IR(j) );
+            if( sj > threshold && sj > Real(0) )
+                uScaled *= 1/Sqrt(sj);
+            else
+            {
+                Zero( uScaled );
+                s(j) = 0;
+                deficient.push_back( j );
+            }
+        }
+        Gemm( NORMAL, NORMAL, Field(1), W, UScaled, WNew );
+        W = WNew;
+
+        // R := diag(s)^{1/2} U^H R
+        Gemm( ADJOINT, NORMAL, Field(1), U, R, RNew );
+        for( Int i=0; i<b; ++i )
+        {
+            auto rNew = RNew( IR(i), ALL );
+            rNew *= Sqrt(s(i));
+        }
+        R = RNew;
+
+        // Replace the deficient columns with random directions, which will be
+        // orthonormalized by the next pass
+        for( const Int j : deficient )
+        {
+            auto w = W( ALL, IR(j) );
+            MakeGaussian( w );
+        }
+        if( pass >= 1 && deficient.empty() )
+            break;
+    }
+
+    // Orthonormalize the random replacements made by the last pass
+    vector<bool> orthonormal( b, true );
+    for( const Int j : deficient )
+        orthonormal[j] = false;
+    Matrix<Field> c;
+    for( const Int j : deficient )
+    {
+        auto w = W( ALL, IR(j) );
+        Real localNormSquared = FrobeniusNorm( w );
+        localNormSquared *= localNormSquared;
+        const Real origNorm =
+          Sqrt( mpi::AllReduce( localNormSquared, comm ) );
+        for( Int gsPass=0; gsPass<2; ++gsPass )
+        {
+            if( basisSize > 0 )
+            {
+                Gemm( ADJOINT, NORMAL, Field(1), V, w, c );
+                mpi::AllReduce( c.Buffer(), basisSize, comm );
+                Gemm( NORMAL, NORMAL, Field(-1), V, c, Field(1), w );
+            }
+            Gemm( ADJOINT, NORMAL, Field(1), W, w, c );
+            mpi::AllReduce( c.Buffer(), b, comm );
+            for( Int k=0; k<b; ++k )
+                if( !orthonormal[k] )
+                    c(k,0) = 0;
+            Gemm( NORMAL, NORMAL, Field(-1), W, c, Field(1), w );
+        }
+        localNormSquared = FrobeniusNorm( w );
+        localNormSquared *= localNormSquared;
+        const Real norm = Sqrt( mpi::AllReduce( localNormSquared, comm ) );
+        if( !(norm > b*eps*origNorm) )
+            RuntimeError
+            ("Could not extend the basis of ",basisSize," vectors by ",b,
+             " orthonormal directions");
+        w *= 1/norm;
+        orthonormal[j] = true;
+    }
+}
+
+} // namespace block_lanczos
+
+// Thick-restart block Lanczos
+// ===========================
+// Compute the numEig largest (algebraic) eigenpairs of the Hermitian operator
+// applied by applyA(X,Y), which must set the local rows of Y := A X from the
+// local rows of the block X, using a block Krylov basis of width at most
+// ctrl.basisSize (plus one block).
+//
+// Each expansion step applies A to a single block (BLAS-3) and then fully
+// reorthogonalizes the result against the entire basis (at least two passes
+// of block classical Gram-Schmidt, each followed by SVQB; see
+// block_lanczos::Orthonormalize), so that the projected matrix H is generally
+// block-tridiagonal with an "arrowhead" formed by the kept Ritz vectors.
+// Whenever the basis is full, the Ritz pairs of H are formed and each Ritz
+// vector is tested for convergence by its residual norm, || R E^H y ||_2,
+// where R is the coupling to the residual block. If not enough have
+// converged, the basis is (thickly) restarted with the leading Ritz vectors
+// and the residual block.
+template<typename Field,class ApplyAType>
+BlockLanczosInfo HermitianEigTop
+(       Int n,
+        Int localHeight,
+        mpi::Comm comm,
+  const ApplyAType& applyA,
+        Int numEig,
+        Matrix<Base<Field>>& w,
+        Matrix<Field>& XLoc,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Real eps = limits::Epsilon<Real>();
+    const Real tol = ( ctrl.tol > Real(0) ? ctrl.tol : Sqrt(eps) );
+    const Int b = ctrl.blockSize;
+    if( b < 1 )
+        LogicError("The block size must be positive");
+    if( numEig < 1 )
+        LogicError("At least one eigenpair must be requested");
+    Int m = ( ctrl.basisSize > 0 ?
+              ctrl.basisSize :
+              Max( 2*numEig, numEig+3*b ) );
+    m = Min( m, n-b );
+    if( m < numEig+b )
+        LogicError
+        ("The basis size, ",m,", must be at least the number of eigenpairs "
+         "plus the block size, ",numEig+b,"; consider a dense eigensolver");
+    const bool progress = ctrl.progress && mpi::Rank(comm) == 0;
+
+    // V holds the basis followed by the residual block
+    Matrix<Field> V, H, W, C, R, RRes;
+    Zeros( V, localHeight, m+b );
+    Zeros( H, m, m );
+
+    // Start from a random block
+    {
+        auto V0 = V( ALL, IR(0,b) );
+        MakeGaussian( V0 );
+        Matrix<Field> emptyBasis;
+        Zeros( emptyBasis, localHeight, 0 );
+        block_lanczos::Orthonormalize( emptyBasis, V0, C, R, comm );
+    }
+
+    BlockLanczosInfo info;
+    Int s = 0;
+    Matrix<Real> theta;
+    Matrix<Field> Y, T, RY, VKeep, Q;
+    HermitianEigCtrl<Field> eigCtrl;
+    eigCtrl.tridiagEigCtrl.sort = DESCENDING;
+    for( Int restart=0; ; ++restart )
+    {
+        // Expand the basis until it is full
+        // =================================
+        while( s+b <= m )
+        {
+            auto Vs = V( ALL, IR(s,s+b) );
+            applyA( Vs, W );
+            ++info.numApplications;
+
+            // Columns s through s+b-1 of (the upper triangle of) H are the
+            // coefficients of the projection of A V_s onto the basis
+            auto VBasis = V( ALL, IR(0,s+b) );
+            block_lanczos::Orthonormalize( VBasis, W, C, R, comm );
+            auto HCol = H( IR(0,s+b), IR(s,s+b) );
+            HCol = C;
+            auto VNext = V( ALL, IR(s+b,s+2*b) );
+            VNext = W;
+            RRes = R;
+            s += b;
+        }
+
+        // Form the Ritz pairs and test them for convergence
+        // =================================================
+        T = H( IR(0,s), IR(0,s) );
+        HermitianEig( UPPER, T, theta, Y, eigCtrl );
+        auto YLast = Y( IR(s-b,s), ALL );
+        Gemm( NORMAL, NORMAL, Field(1), RRes, YLast, RY );
+        const Real scale = Max( Max(Abs(theta(0)),Abs(theta(s-1))), eps );
+        Int numConverged = 0;
+        while( numConverged < numEig &&
+               FrobeniusNorm(RY(ALL,IR(numConverged))) <= tol*scale )
+            ++numConverged;
+        info.numRestarts = restart;
+        info.numConverged = numConverged;
+        if( progress )
+            Output
+            ("Restart ",restart,": ",numConverged," of ",numEig,
+             " Ritz pairs converged");
+        if( numConverged == numEig || restart == ctrl.maxRestarts )
+            break;
+
+        // Restart with the leading Ritz vectors and the residual block
+        // =============================================================
+        const Int numKeep = Min( m-b, numEig+b );
+        Gemm
+        ( NORMAL, NORMAL,
+          Field(1), V(ALL,IR(0,s)), Y(ALL,IR(0,numKeep)), VKeep );
+        Q = V( ALL, IR(s,s+b) );
+        auto VKept = V( ALL, IR(0,numKeep) );
+        VKept = VKeep;
+        auto VRes = V( ALL, IR(numKeep,numKeep+b) );
+        VRes = Q;
+        Zero( H );
+        for( Int j=0; j<numKeep; ++j )
+            H(j,j) = theta(j);
+        s = numKeep;
+    }
+    if( info.numConverged < numEig && mpi::Rank(comm) == 0 )
+        Output
+        ("WARNING: Only ",info.numConverged," of ",numEig," Ritz pairs "
+         "converged within ",ctrl.maxRestarts," restarts");
+
+    w = theta( IR(0,numEig), ALL );
+    Gemm
+    ( NORMAL, NORMAL, Field(1), V(ALL,IR(0,s)), Y(ALL,IR(0,numEig)), XLoc );
+    return info;
+}
+
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const Matrix<Field>& A,
+        Int numEig,
+        Matrix<Base<Field>>& w,
+        Matrix<Field>& X,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { Gemm( NORMAL, NORMAL, Field(1), A, XBlock, YBlock ); };
+    return HermitianEigTop
+      ( n, n, mpi::COMM_SELF, applyA, numEig, w, X, ctrl );
+}
+
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const SparseMatrix<Field>& A,
+        Int numEig,
+        Matrix<Base<Field>>& w,
+        Matrix<Field>& X,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Int n = A.Height();
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      {
+          Zeros( YBlock, n, XBlock.Width() );
+          Multiply( NORMAL, Field(1), A, XBlock, Field(0), YBlock );
+      };
+    return HermitianEigTop
+      ( n, n, mpi::COMM_SELF, applyA, numEig, w, X, ctrl );
+}
+
+namespace block_lanczos {
+
+// Apply a dense distributed matrix to the local rows of a [VC,STAR] block
+template<typename Field>
+void ApplyDense
+( Orientation orientation,
+  const AbstractDistMatrix<Field>& A,
+  const Matrix<Field>& XLoc,
+        Matrix<Field>& YLoc )
+{
+    EL_DEBUG_CSE
+    const Grid& g = A.Grid();
+    const Int height = ( orientation == NORMAL ? A.Height() : A.Width() );
+    const Int width = ( orientation == NORMAL ? A.Width() : A.Height() );
+    const Int numRHS = XLoc.Width();
+    DistMatrix<Field,VC,STAR> X(g), Y(g);
+    X.LockedAttach( width, numRHS, g, 0, 0, XLoc );
+    Zeros( YLoc, Length(height,g.VCRank(),g.Size()), numRHS );
+    Y.Attach( height, numRHS, g, 0, 0, YLoc );
+    Gemm( orientation, NORMAL, Field(1), A, X, Field(0), Y );
+}
+
+// Apply a sparse distributed matrix to the local rows of a DistMultiVec
+template<typename Field>
+void ApplySparse
+( Orientation orientation,
+  const DistSparseMatrix<Field>& A,
+  const Matrix<Field>& XLoc,
+        Matrix<Field>& YLoc )
+{
+    EL_DEBUG_CSE
+    const Grid& g = A.Grid();
+    const Int height = ( orientation == NORMAL ? A.Height() : A.Width() );
+    const Int width = ( orientation == NORMAL ? A.Width() : A.Height() );
+    DistMultiVec<Field> X(g), Y(g);
+    Zeros( X, width, XLoc.Width() );
+    X.Matrix() = XLoc;
+    Zeros( Y, height, XLoc.Width() );
+    Multiply( orientation, Field(1), A, X, Field(0), Y );
+    YLoc = Y.Matrix();
+}
+
+} // namespace block_lanczos
+
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const AbstractDistMatrix<Field>& A,
+        Int numEig,
+        AbstractDistMatrix<Base<Field>>& wPre,
+        AbstractDistMatrix<Field>& XPre,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = A.Grid();
+    const Int n = A.Height();
+    const Int localHeight = Length( n, g.VCRank(), g.Size() );
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { block_lanczos::ApplyDense( NORMAL, A, XBlock, YBlock ); };
+    Matrix<Real> w;
+    Matrix<Field> XLoc;
+    auto info = HermitianEigTop
+      ( n, localHeight, g.VCComm(), applyA, numEig, w, XLoc, ctrl );
+
+    DistMatrixWriteProxy<Real,Real,STAR,STAR> wProx( wPre );
+    wProx.Get().Resize( numEig, 1 );
+    Copy( w, wProx.Get().Matrix() );
+    DistMatrix<Field,VC,STAR> X(g);
+    X.Attach( n, numEig, g, 0, 0, XLoc );
+    Copy( X, XPre );
+    return info;
+}
+
+template<typename Field>
+BlockLanczosInfo HermitianEigTop
+( const DistSparseMatrix<Field>& A,
+        Int numEig,
+        Matrix<Base<Field>>& w,
+        DistMultiVec<Field>& X,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Grid& g = A.Grid();
+    const Int n = A.Height();
+    Zeros( X, n, numEig );
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { block_lanczos::ApplySparse( NORMAL, A, XBlock, YBlock ); };
+    return HermitianEigTop
+      ( n, X.LocalHeight(), g.Comm(), applyA, numEig, w, X.Matrix(), ctrl );
+}
+
+// Truncated SVD
+// =============
+// The numVals dominant singular triplets of A are computed by applying
+// thick-restart block Lanczos to the smaller of A^H A and A A^H; the singular
+// vectors on the other side are then recovered by an application of A (or
+// A^H) and a diagonal scaling. Since the eigenvalues of the normal operator
+// are the squares of the singular values, the relative accuracy of the
+// computed singular values which are much smaller than the largest one is
+// reduced accordingly.
+namespace block_lanczos {
+
+template<typename Field,class ApplyAType,class ApplyAAdjType>
+BlockLanczosInfo TruncatedSVD
+(       Int m,
+        Int n,
+        Int localHeightM,
+        Int localHeightN,
+        mpi::Comm comm,
+  const ApplyAType& applyA,
+  const ApplyAAdjType& applyAAdj,
+        Int numVals,
+        Matrix<Field>& ULoc,
+        Matrix<Base<Field>>& s,
+        Matrix<Field>& VLoc,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    Matrix<Field> Z;
+    BlockLanczosInfo info;
+    if( m >= n )
+    {
+        auto applyNormal =
+          [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+          {
+              applyA( XBlock, Z );
+              applyAAdj( Z, YBlock );
+          };
+        info = HermitianEigTop
+          ( n, localHeightN, comm, applyNormal, numVals, s, VLoc, ctrl );
+        applyA( VLoc, ULoc );
+    }
+    else
+    {
+        auto applyNormal =
+          [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+          {
+              applyAAdj( XBlock, Z );
+              applyA( Z, YBlock );
+          };
+        info = HermitianEigTop
+          ( m, localHeightM, comm, applyNormal, numVals, s, ULoc, ctrl );
+        applyAAdj( ULoc, VLoc );
+    }
+
+    // Convert the eigenvalues into singular values and normalize the
+    // recovered singular vectors
+    auto& Other = ( m >= n ? ULoc : VLoc );
+    for( Int j=0; j<numVals; ++j )
+    {
+        s(j) = Sqrt( Max( s(j), Real(0) ) );
+        if( s(j) > Real(0) )
+        {
+            auto other = Other( ALL, IR(j) );
+            other *= 1/s(j);
+        }
+    }
+    return info;
+}
+
+} // namespace block_lanczos
+
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const Matrix<Field>& A,
+        Int numVals,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& s,
+        Matrix<Field>& V,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { Gemm( NORMAL, NORMAL, Field(1), A, XBlock, YBlock ); };
+    auto applyAAdj = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { Gemm( ADJOINT, NORMAL, Field(1), A, XBlock, YBlock ); };
+    return block_lanczos::TruncatedSVD
+      ( m, n, m, n, mpi::COMM_SELF, applyA, applyAAdj, numVals, U, s, V,
+        ctrl );
+}
+
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const SparseMatrix<Field>& A,
+        Int numVals,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& s,
+        Matrix<Field>& V,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      {
+          Zeros( YBlock, m, XBlock.Width() );
+          Multiply( NORMAL, Field(1), A, XBlock, Field(0), YBlock );
+      };
+    auto applyAAdj = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      {
+          Zeros( YBlock, n, XBlock.Width() );
+          Multiply( ADJOINT, Field(1), A, XBlock, Field(0), YBlock );
+      };
+    return block_lanczos::TruncatedSVD
+      ( m, n, m, n, mpi::COMM_SELF, applyA, applyAAdj, numVals, U, s, V,
+        ctrl );
+}
+
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const AbstractDistMatrix<Field>& A,
+        Int numVals,
+        AbstractDistMatrix<Field>& UPre,
+        AbstractDistMatrix<Base<Field>>& sPre,
+        AbstractDistMatrix<Field>& VPre,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = A.Grid();
+    const Int m = A.Height();
+    const Int n = A.Width();
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { block_lanczos::ApplyDense( NORMAL, A, XBlock, YBlock ); };
+    auto applyAAdj = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { block_lanczos::ApplyDense( ADJOINT, A, XBlock, YBlock ); };
+    Matrix<Field> ULoc, VLoc;
+    Matrix<Real> s;
+    auto info = block_lanczos::TruncatedSVD
+      ( m, n,
+        Length(m,g.VCRank(),g.Size()), Length(n,g.VCRank(),g.Size()),
+        g.VCComm(), applyA, applyAAdj, numVals, ULoc, s, VLoc, ctrl );
+
+    DistMatrixWriteProxy<Real,Real,STAR,STAR> sProx( sPre );
+    sProx.Get().Resize( numVals, 1 );
+    Copy( s, sProx.Get().Matrix() );
+    DistMatrix<Field,VC,STAR> U(g), V(g);
+    U.Attach( m, numVals, g, 0, 0, ULoc );
+    V.Attach( n, numVals, g, 0, 0, VLoc );
+    Copy( U, UPre );
+    Copy( V, VPre );
+    return info;
+}
+
+template<typename Field>
+BlockLanczosInfo TruncatedSVD
+( const DistSparseMatrix<Field>& A,
+        Int numVals,
+        DistMultiVec<Field>& U,
+        Matrix<Base<Field>>& s,
+        DistMultiVec<Field>& V,
+  const BlockLanczosCtrl<Base<Field>>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Grid& g = A.Grid();
+    const Int m = A.Height();
+    const Int n = A.Width();
+    Zeros( U, m, numVals );
+    Zeros( V, n, numVals );
+    auto applyA = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { block_lanczos::ApplySparse( NORMAL, A, XBlock, YBlock ); };
+    auto applyAAdj = [&]( const Matrix<Field>& XBlock, Matrix<Field>& YBlock )
+      { block_lanczos::ApplySparse( ADJOINT, A, XBlock, YBlock ); };
+    return block_lanczos::TruncatedSVD
+      ( m, n, U.LocalHeight(), V.LocalHeight(), g.Comm(), applyA, applyAAdj,
+        numVals, U.Matrix(), s, V.Matrix(), ctrl );
+}
+
+} // namespace El
+
+#endif // ifndef EL_SPECTRAL_BLOCKLANCZOS_HPP
@@ -316,6 +316,188 @@ void TwoByTwo
     }
 }
 
+inline Int TwoStageBandwidth( Int n, Int bandwidth )
+{
+    if( bandwidth <= 0 )
+        bandwidth = Blocksize();
+    return Max( Min( bandwidth, n-1 ), Int(1) );
+}
+
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        Matrix<Field>& A,
+        Matrix<Base<Field>>& w,
+  const HermitianEigTwoStageCtrl<Field>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Int bandwidth =
+      TwoStageBandwidth( A.Height(), ctrl.bandwidth );
+    Timer timer;
+    if( ctrl.timeStages )
+        timer.Start();
+    Matrix<Field> householderScalars, dSub;
+    Matrix<Base<Field>> signature, d;
+    herm_tridiag::BulgeChaseReflectors<Field> reflectors;
+    herm_tridiag::TwoStage
+    ( uplo, A, bandwidth, householderScalars, signature, d, dSub, reflectors,
+      false );
+    if( ctrl.timeStages )
+    {
+        Output("Two-stage reduction: ",timer.Stop()," seconds");
+        timer.Start();
+    }
+
+    HermitianEigInfo info;
+    info.tridiagEigInfo =
+      HermitianTridiagEig( d, dSub, w, ctrl.tridiagEigCtrl );
+    if( ctrl.timeStages )
+        Output("Tridiagonal eigensolver: ",timer.Stop()," seconds");
+    return info;
+}
+
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Base<Field>>& w,
+  const HermitianEigTwoStageCtrl<Field>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = A.Grid();
+    const Int bandwidth =
+      TwoStageBandwidth( A.Height(), ctrl.bandwidth );
+    Timer timer;
+    if( ctrl.timeStages && g.Rank() == 0 )
+        timer.Start();
+    DistMatrix<Field,STAR,STAR> householderScalars(g), dSub(g);
+    DistMatrix<Real,STAR,STAR> signature(g), d(g);
+    Matrix<Real> dLoc;
+    Matrix<Field> dSubLoc;
+    herm_tridiag::BulgeChaseReflectors<Field> reflectors;
+    herm_tridiag::TwoStage
+    ( uplo, A, bandwidth, householderScalars, signature, dLoc, dSubLoc,
+      reflectors, false );
+    d.Resize( dLoc.Height(), 1 );
+    dSub.Resize( dSubLoc.Height(), 1 );
+    d.Matrix() = dLoc;
+    dSub.Matrix() = dSubLoc;
+    if( ctrl.timeStages && g.Rank() == 0 )
+    {
+        Output("Two-stage reduction: ",timer.Stop()," seconds");
+        timer.Start();
+    }
+
+    HermitianEigInfo info;
+    info.tridiagEigInfo =
+      HermitianTridiagEig( d, dSub, w, ctrl.tridiagEigCtrl );
+    if( ctrl.timeStages && g.Rank() == 0 )
+        Output("Tridiagonal eigensolver: ",timer.Stop()," seconds");
+    return info;
+}
+
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        Matrix<Field>& A,
+        Matrix<Base<Field>>& w,
+        Matrix<Field>& Q,
+  const HermitianEigTwoStageCtrl<Field>& ctrl )
+{
+    EL_DEBUG_CSE
+    const Int bandwidth =
+      TwoStageBandwidth( A.Height(), ctrl.bandwidth );
+    Timer timer;
+    if( ctrl.timeStages )
+        timer.Start();
+    Matrix<Field> householderScalars, dSub;
+    Matrix<Base<Field>> signature, d;
+    herm_tridiag::BulgeChaseReflectors<Field> reflectors;
+    herm_tridiag::TwoStage
+    ( uplo, A, bandwidth, householderScalars, signature, d, dSub, reflectors );
+    if( ctrl.timeStages )
+    {
+        Output("Two-stage reduction: ",timer.Stop()," seconds");
+        timer.Start();
+    }
+
+    auto tridiagEigCtrl = ctrl.tridiagEigCtrl;
+    tridiagEigCtrl.wantEigVecs = true;
+    tridiagEigCtrl.accumulateEigVecs = false;
+    HermitianEigInfo info;
+    info.tridiagEigInfo =
+      HermitianTridiagEig( d, dSub, w, Q, tridiagEigCtrl );
+    if( ctrl.timeStages )
+    {
+        Output("Tridiagonal eigensolver: ",timer.Stop()," seconds");
+        timer.Start();
+    }
+
+    herm_tridiag::ApplyTwoStageQ
+    ( A, bandwidth, householderScalars, signature, reflectors, Q );
+    if( ctrl.timeStages )
+        Output("Backtransformation: ",timer.Stop()," seconds");
+    return info;
+}
+
+template<typename Field>
+HermitianEigInfo
+TwoStage
+(       UpperOrLower uplo,
+        AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Base<Field>>& w,
+        AbstractDistMatrix<Field>& Q,
+  const HermitianEigTwoStageCtrl<Field>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = A.Grid();
+    const Int bandwidth =
+      TwoStageBandwidth( A.Height(), ctrl.bandwidth );
+    Timer timer;
+    if( ctrl.timeStages && g.Rank() == 0 )
+        timer.Start();
+    DistMatrix<Field,STAR,STAR> householderScalars(g), dSub(g);
+    DistMatrix<Real,STAR,STAR> signature(g), d(g);
+    Matrix<Real> dLoc;
+    Matrix<Field> dSubLoc;
+    herm_tridiag::BulgeChaseReflectors<Field> reflectors;
+    herm_tridiag::TwoStage
+    ( uplo, A, bandwidth, householderScalars, signature, dLoc, dSubLoc,
+      reflectors );
+    d.Resize( dLoc.Height(), 1 );
+    dSub.Resize( dSubLoc.Height(), 1 );
+    d.Matrix() = dLoc;
+    dSub.Matrix() = dSubLoc;
+    if( ctrl.timeStages && g.Rank() == 0 )
+    {
+        Output("Two-stage reduction: ",timer.Stop()," seconds");
+        timer.Start();
+    }
+
+    auto tridiagEigCtrl = ctrl.tridiagEigCtrl;
+    tridiagEigCtrl.wantEigVecs = true;
+    tridiagEigCtrl.accumulateEigVecs = false;
+    HermitianEigInfo info;
+    info.tridiagEigInfo =
+      HermitianTridiagEig( d, dSub, w, Q, tridiagEigCtrl );
+    if( ctrl.timeStages && g.Rank() == 0 )
+    {
+        Output("Tridiagonal eigensolver: ",timer.Stop()," seconds");
+        timer.Start();
+    }
+
+    herm_tridiag::ApplyTwoStageQ
+    ( A, bandwidth, householderScalars, signature, reflectors, Q );
+    if( ctrl.timeStages && g.Rank() == 0 )
+        Output("Backtransformation: ",timer.Stop()," seconds");
+    return info;
+}
+
 } // namespace herm_eig
 } // namespace El
 
@@ -0,0 +1,815 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_SPECTRAL_QDWH_HPP
+#define EL_SPECTRAL_QDWH_HPP
+
+namespace El {
+namespace polar {
+namespace zolo {
+
+// Both QDWH,
+//
+//   Y. Nakatsukasa, Z. Bai, and F. Gygi, "Optimizing Halley's iteration for
+//   computing the matrix polar decomposition", SIAM J. Matrix Anal. Appl.,
+//   31(5), 2010,
+//
+// and Zolo-PD,
+//
+//   Y. Nakatsukasa and R. W. Freund, "Computing fundamental matrix
+//   decompositions accurately via the matrix sign function in two
+//   iterations: The power of Zolotarev's functions", SIAM Review, 58(3),
+//   2016,
+//
+// start from X_0 = A / ||A||_2, whose singular values lie in [l_0,1], and
+// iterate
+//
+//   X_{k+1} := alpha X_k + sum_j beta_j X_k (X_k^H X_k + gamma_j I)^{-1},
+//
+// which maps each singular value of X_k through the best odd rational
+// approximation of the sign function on [l_k,1] of its type. QDWH uses a
+// single term per iteration (and at most six iterations in double
+// precision), whereas Zolo-PD uses up to eight independent terms and
+// converges within two iterations.
+//
+// Since the singular values of X_k lie in [l_k,1], the two-norm condition
+// number of X_k^H X_k + gamma I is at most (1+gamma)/(l_k^2+gamma). A term
+// is formed from the Cholesky factor of this shifted Gram matrix whenever
+// the bound is at most CholQDWHCtrl::cholThreshold, and otherwise from a QR
+// factorization of [X_k; sqrt(gamma) I], which requires roughly three times
+// as much work. The Gram matrix is formed once per iterate and reused by all
+// of the Cholesky-based terms.
+
+// The weights of the QDWH iteration
+//   X := X (a I + b X^H X) (I + c X^H X)^{-1}
+// for an iterate whose singular values lie in [l,1]
+template<typename Real>
+void QDWHWeights( Real l, Real& a, Real& b, Real& c )
+{
+    EL_DEBUG_CSE
+    const Real lSq = l*l;
+    const Real d =
+      Pow( Real(4)*(Real(1)-lSq)/(lSq*lSq), Real(1)/Real(3) );
+    const Real sqrtOnePlusD = Sqrt( Real(1)+d );
+    a = sqrtOnePlusD +
+      Sqrt( Real(8) - Real(4)*d +
+            Real(8)*(Real(2)-lSq)/(lSq*sqrtOnePlusD) ) / Real(2);
+    b = (a-Real(1))*(a-Real(1)) / Real(4);
+    c = a + b - Real(1);
+}
+
+// The coefficients of the type (2r+1,2r) Zolotarev function
+//
+//   alpha x + sum_{j=0}^{r-1} beta_j x / (x^2 + gamma_j)
+//
+// which best approximates the sign function on [l,1], as well as the image,
+// lNew, of l (which lower bounds the image of [l,1]).
+//
+// The required values of sc(u;sqrt(1-l^2)) are computed as sinh of the
+// imaginary amplitude of sn(i u;l), via Jacobi's imaginary transformation,
+// using the descending Landen sequence of the (small) modulus l. Unlike
+// the amplitude of sn(u;sqrt(1-l^2)), which approaches pi/2 for all but the
+// smallest arguments, this retains full relative accuracy.
+template<typename Real>
+void Zolotarev
+( Real l,
+  Int numTerms,
+  Real& alpha,
+  vector<Real>& beta,
+  vector<Real>& gamma,
+  Real& lNew )
+{
+    EL_DEBUG_CSE
+    const Real eps = limits::Epsilon<Real>();
+    l = Min( l, Real(1)-Real(2)*eps );
+
+    // K' = K(sqrt(1-l^2)) = pi / (2 AGM(1,l))
+    Real aAGM=1, bAGM=l;
+    while( Abs(aAGM-bAGM) > eps*aAGM )
+    {
+        const Real aNext = (aAGM+bAGM)/Real(2);
+        bAGM = Sqrt( aAGM*bAGM );
+        aAGM = aNext;
+    }
+    const Real KPrime = Pi<Real>() / (Real(2)*aAGM);
+
+    // The descending Landen sequence of the modulus l
+    vector<Real> aLanden(1,Real(1)), cLanden(1,l);
+    Real bLanden = Sqrt( (Real(1)-l)*(Real(1)+l) );
+    while( cLanden.back() > eps*aLanden.back() )
+    {
+        const Real aNext = (aLanden.back()+bLanden)/Real(2);
+        cLanden.push_back( cLanden.back()*cLanden.back()/(Real(4)*aNext) );
+        bLanden = Sqrt( aLanden.back()*bLanden );
+        aLanden.push_back( aNext );
+    }
+    const Int numLanden = aLanden.size()-1;
+
+    // Beyond this magnitude, sinh(theta) = exp(theta)/2 to machine precision
+    const Real expCutoff = -Log(eps)/Real(2);
+    vector<Real> coefs(2*numTerms);
+    for( Int i=1; i<=2*numTerms; ++i )
+    {
+        const Real u = i*KPrime/Real(2*numTerms+1);
+        Real theta = aLanden[numLanden]*u;
+        for( Int k=0; k<numLanden; ++k )
+            theta *= Real(2);
+        for( Int k=numLanden; k>0; --k )
+        {
+            // theta := (theta + asinh(s sinh(theta))) / 2, avoiding overflow
+            const Real s = cLanden[k] / aLanden[k];
+            Real phi;
+            if( theta > expCutoff )
+            {
+                const Real logArg = theta + Log(s/Real(2));
+                if( logArg > expCutoff )
+                    phi = theta + Log(s);
+                else
+                    phi = Asinh( Exp(logArg) );
+            }
+            else
+                phi = Asinh( s*Sinh(theta) );
+            theta = (theta+phi) / Real(2);
+        }
+        const Real sc = Sinh( theta );
+        coefs[i-1] = l*l*sc*sc;
+    }
+
+    alpha = 1;
+    for( Int j=0; j<numTerms; ++j )
+        alpha *= (Real(1)+coefs[2*j]) / (Real(1)+coefs[2*j+1]);
+    beta.resize( numTerms );
+    gamma.resize( numTerms );
+    const Real lSq = l*l;
+    lNew = alpha*l;
+    for( Int j=0; j<numTerms; ++j )
+    {
+        Real num=1, den=1;
+        for( Int k=0; k<numTerms; ++k )
+        {
+            num *= coefs[2*j] - coefs[2*k+1];
+            if( k != j )
+                den *= coefs[2*j] - coefs[2*k];
+        }
+        beta[j] = -alpha*num/den;
+        gamma[j] = coefs[2*j];
+        lNew *= (lSq+coefs[2*j+1]) / (lSq+coefs[2*j]);
+    }
+    lNew = Min( lNew, Real(1) );
+}
+
+// The smallest number of terms (at most eight) for which Zolo-PD converges
+// to machine precision within two iterations
+template<typename Real>
+Int ZolotarevNumTerms( Real l )
+{
+    EL_DEBUG_CSE
+    const Int maxTerms = 8;
+    const Real tol = Real(10)*limits::Epsilon<Real>();
+    Real alpha, lOne, lTwo;
+    vector<Real> beta, gamma;
+    for( Int numTerms=1; numTerms<maxTerms; ++numTerms )
+    {
+        Zolotarev( l, numTerms, alpha, beta, gamma, lOne );
+        Zolotarev( lOne, numTerms, alpha, beta, gamma, lTwo );
+        if( Real(1)-lTwo <= tol )
+            return numTerms;
+    }
+    return maxTerms;
+}
+
+// A lower bound on the smallest singular value of the upper-triangular
+// matrix R, whose singular values are at most one
+template<typename Field>
+Base<Field> SingularValueLowerBound( const Matrix<Field>& R )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Real eps = limits::Epsilon<Real>();
+    for( Int j=0; j<R.Height(); ++j )
+        if( R(j,j) == Field(0) )
+            return eps;
+    Matrix<Field> RInv( R );
+    MakeTrapezoidal( UPPER, RInv );
+    TriangularInverse( UPPER, NON_UNIT, RInv );
+    // Since the power iteration approaches ||R^{-1}||_2 from below, its
+    // estimate is inflated slightly
+    const Real invNorm =
+      Min( FrobeniusNorm(RInv), Real(1.1)*TwoNormEstimate(RInv) );
+    return Max( Min( Real(1)/invNorm, Real(1) ), eps );
+}
+
+// Overwrite the tall matrix A with A / ||A||_2 and return a lower bound on
+// its smallest singular value
+template<typename Field>
+Base<Field> Prescale( Matrix<Field>& A )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int n = A.Width();
+    const Real frobNorm = FrobeniusNorm( A );
+    if( frobNorm == Real(0) )
+        return Real(1);
+    const Real twoNorm = Min( frobNorm, Real(1.1)*TwoNormEstimate(A) );
+    Scale( Real(1)/twoNorm, A );
+
+    Matrix<Field> R( A );
+    qr::ExplicitTriang( R );
+    auto RSquare = R( IR(0,n), IR(0,n) );
+    return SingularValueLowerBound( RSquare );
+}
+
+template<typename Field>
+Base<Field> Prescale( DistMatrix<Field>& A )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = A.Grid();
+    const Int n = A.Width();
+    const Real frobNorm = FrobeniusNorm( A );
+    if( frobNorm == Real(0) )
+        return Real(1);
+    Real twoNorm = Min( frobNorm, Real(1.1)*TwoNormEstimate(A) );
+    twoNorm = mpi::AllReduce( twoNorm, mpi::MAX, g.Comm() );
+    Scale( Real(1)/twoNorm, A );
+
+    DistMatrix<Field> R( A );
+    qr::ExplicitTriang( R );
+    DistMatrix<Field,STAR,STAR> R_STAR_STAR( R(IR(0,n),IR(0,n)) );
+    // The estimate of ||R^{-1}||_2 is randomized, so the most conservative
+    // bound is agreed upon
+    const Real l = SingularValueLowerBound( R_STAR_STAR.Matrix() );
+    return mpi::AllReduce( l, mpi::MIN, g.Comm() );
+}
+
+template<typename Real>
+bool UseCholesky( Real gamma, Real l, const CholQDWHCtrl& ctrl )
+{
+    return ctrl.cholesky &&
+      Real(1)+gamma <= Real(ctrl.cholThreshold)*(l*l+gamma);
+}
+
+// T := X (X^H X + gamma I)^{-1} = Q_T Q_B^H / sqrt(gamma), where
+// [X; sqrt(gamma) I] = [Q_T; Q_B] R
+template<typename Field>
+void QRTerm
+( const Matrix<Field>& X,
+        Base<Field> gamma,
+        Matrix<Field>& T,
+  const CholQDWHCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int m = X.Height();
+    const Int n = X.Width();
+    const Real sqrtGamma = Sqrt( gamma );
+    Matrix<Field> Y;
+    Zeros( Y, m+n, n );
+    auto YT = Y( IR(0,m), ALL );
+    auto YB = Y( IR(m,m+n), ALL );
+    YT = X;
+    ShiftDiagonal( YB, Field(sqrtGamma) );
+
+    QRCtrl<Real> qrCtrl;
+    qrCtrl.colPiv = ctrl.colPiv;
+    qr::ExplicitUnitary( Y, true, qrCtrl );
+    auto QT = Y( IR(0,m), ALL );
+    auto QB = Y( IR(m,m+n), ALL );
+    Gemm( NORMAL, ADJOINT, Field(Real(1)/sqrtGamma), QT, QB, T );
+}
+
+template<typename Field>
+void QRTerm
+( const DistMatrix<Field>& X,
+        Base<Field> gamma,
+        DistMatrix<Field>& T,
+  const CholQDWHCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int m = X.Height();
+    const Int n = X.Width();
+    const Real sqrtGamma = Sqrt( gamma );
+    DistMatrix<Field> Y( X.Grid() );
+    Zeros( Y, m+n, n );
+    auto YT = Y( IR(0,m), ALL );
+    auto YB = Y( IR(m,m+n), ALL );
+    YT = X;
+    ShiftDiagonal( YB, Field(sqrtGamma) );
+
+    QRCtrl<Real> qrCtrl;
+    qrCtrl.colPiv = ctrl.colPiv;
+    qr::ExplicitUnitary( Y, true, qrCtrl );
+    auto QT = Y( IR(0,m), ALL );
+    auto QB = Y( IR(m,m+n), ALL );
+    Gemm( NORMAL, ADJOINT, Field(Real(1)/sqrtGamma), QT, QB, T );
+}
+
+// T := X (X^H X + gamma I)^{-1} = X W^{-1} W^{-H}, where
+// X^H X + gamma I = W^H W and the upper triangle of 'gram' holds X^H X
+template<typename Field>
+void CholeskyTerm
+( const Matrix<Field>& X,
+  const Matrix<Field>& gram,
+        Base<Field> gamma,
+        Matrix<Field>& T )
+{
+    EL_DEBUG_CSE
+    Matrix<Field> W( gram );
+    ShiftDiagonal( W, Field(gamma) );
+    Cholesky( UPPER, W );
+    T = X;
+    Trsm( RIGHT, UPPER, NORMAL, NON_UNIT, Field(1), W, T );
+    Trsm( RIGHT, UPPER, ADJOINT, NON_UNIT, Field(1), W, T );
+}
+
+template<typename Field>
+void CholeskyTerm
+( const DistMatrix<Field>& X,
+  const DistMatrix<Field>& gram,
+        Base<Field> gamma,
+        DistMatrix<Field>& T )
+{
+    EL_DEBUG_CSE
+    DistMatrix<Field> W( gram );
+    ShiftDiagonal( W, Field(gamma) );
+    Cholesky( UPPER, W );
+    T = X;
+    Trsm( RIGHT, UPPER, NORMAL, NON_UNIT, Field(1), W, T );
+    Trsm( RIGHT, UPPER, ADJOINT, NON_UNIT, Field(1), W, T );
+}
+
+// S := sum_j beta_j X (X^H X + gamma_j I)^{-1}, where the singular values of
+// X lie in [l,1]
+template<typename Field>
+void AccumulateTerms
+( const Matrix<Field>& X,
+  const vector<Base<Field>>& beta,
+  const vector<Base<Field>>& gamma,
+        Base<Field> l,
+        Matrix<Field>& S,
+  const CholQDWHCtrl& ctrl,
+        CholQDWHInfo& info )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int n = X.Width();
+    Zeros( S, X.Height(), n );
+    bool formedGram = false;
+    Matrix<Field> gram, T;
+    Timer timer;
+    for( size_t j=0; j<beta.size(); ++j )
+    {
+        timer.Start();
+        if( UseCholesky( gamma[j], l, ctrl ) )
+        {
+            if( !formedGram )
+            {
+                Zeros( gram, n, n );
+                Herk( UPPER, ADJOINT, Real(1), X, Real(0), gram );
+                formedGram = true;
+            }
+            CholeskyTerm( X, gram, gamma[j], T );
+            info.cholTime += timer.Stop();
+            ++info.numCholIts;
+        }
+        else
+        {
+            QRTerm( X, gamma[j], T, ctrl );
+            info.qrTime += timer.Stop();
+            ++info.numQRIts;
+        }
+        Axpy( Field(beta[j]), T, S );
+    }
+}
+
+template<typename Field>
+void AccumulateTerms
+( const DistMatrix<Field>& X,
+  const vector<Base<Field>>& beta,
+  const vector<Base<Field>>& gamma,
+        Base<Field> l,
+        DistMatrix<Field>& S,
+  const CholQDWHCtrl& ctrl,
+        CholQDWHInfo& info )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = X.Grid();
+    const Int n = X.Width();
+    Zeros( S, X.Height(), n );
+    bool formedGram = false;
+    DistMatrix<Field> gram(g), T(g);
+    Timer timer;
+    for( size_t j=0; j<beta.size(); ++j )
+    {
+        timer.Start();
+        if( UseCholesky( gamma[j], l, ctrl ) )
+        {
+            if( !formedGram )
+            {
+                Zeros( gram, n, n );
+                Herk( UPPER, ADJOINT, Real(1), X, Real(0), gram );
+                formedGram = true;
+            }
+            CholeskyTerm( X, gram, gamma[j], T );
+            info.cholTime += timer.Stop();
+            ++info.numCholIts;
+        }
+        else
+        {
+            QRTerm( X, gamma[j], T, ctrl );
+            info.qrTime += timer.Stop();
+            ++info.numQRIts;
+        }
+        Axpy( Field(beta[j]), T, S );
+    }
+}
+
+// S := sum_j beta_j X (X^H X + gamma_j I)^{-1}, with the terms formed in
+// parallel on the parts of a partition of X's grid, the j'th term being
+// assigned to part j mod (the number of parts)
+template<typename Field>
+void AccumulateTerms
+( const DistMatrix<Field>& X,
+  const vector<Base<Field>>& beta,
+  const vector<Base<Field>>& gamma,
+        Base<Field> l,
+        DistMatrix<Field>& S,
+  const GridPartition& termGroups,
+  const CholQDWHCtrl& ctrl,
+        CholQDWHInfo& info )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = X.Grid();
+    const Int numGroups = termGroups.NumParts();
+    const Int myGroup = termGroups.MyPart();
+
+    vector<unique_ptr<DistMatrix<Field>>> XGroups(numGroups),
+      SGroups(numGroups);
+    for( Int k=0; k<numGroups; ++k )
+    {
+        XGroups[k].reset( new DistMatrix<Field>(termGroups.PartGrid(k)) );
+        SGroups[k].reset( new DistMatrix<Field>(termGroups.PartGrid(k)) );
+        copy::TranslateBetweenGrids( X, *XGroups[k] );
+        Zeros( *SGroups[k], X.Height(), X.Width() );
+    }
+    CholQDWHInfo groupInfo;
+    if( myGroup >= 0 )
+    {
+        vector<Real> betaGroup, gammaGroup;
+        for( size_t j=myGroup; j<beta.size(); j+=numGroups )
+        {
+            betaGroup.push_back( beta[j] );
+            gammaGroup.push_back( gamma[j] );
+        }
+        AccumulateTerms
+        ( *XGroups[myGroup], betaGroup, gammaGroup, l, *SGroups[myGroup],
+          ctrl, groupInfo );
+        XGroups[myGroup]->Empty();
+    }
+
+    // Each subgrid only counted and timed its own terms, so sum the counts
+    // of one process from each subgrid and keep the slowest times
+    const bool groupRoot = myGroup >= 0 &&
+      g.OwningRank() == termGroups.PartOffset(myGroup);
+    Int counts[2] = { 0, 0 };
+    if( groupRoot )
+    {
+        counts[0] = groupInfo.numQRIts;
+        counts[1] = groupInfo.numCholIts;
+    }
+    mpi::AllReduce( counts, 2, g.Comm() );
+    double times[2] = { groupInfo.qrTime, groupInfo.cholTime };
+    mpi::AllReduce( times, 2, mpi::MAX, g.Comm() );
+    info.numQRIts += counts[0];
+    info.numCholIts += counts[1];
+    info.qrTime += times[0];
+    info.cholTime += times[1];
+
+    Zeros( S, X.Height(), X.Width() );
+    DistMatrix<Field> SGroup(g);
+    for( Int k=0; k<numGroups; ++k )
+    {
+        copy::TranslateBetweenGrids( *SGroups[k], SGroup );
+        Axpy( Field(1), SGroup, S );
+    }
+}
+
+// Agree upon the (slowest) times of the processes
+inline void ReduceTimes( CholQDWHInfo& info, mpi::Comm comm )
+{
+    EL_DEBUG_CSE
+    double times[4] =
+      { info.estimateTime, info.qrTime, info.cholTime, info.totalTime };
+    mpi::AllReduce( times, 4, mpi::MAX, comm );
+    info.estimateTime = times[0];
+    info.qrTime = times[1];
+    info.cholTime = times[2];
+    info.totalTime = times[3];
+}
+
+// P := (P + P^H) / 2
+template<typename Field>
+void HermitianPart( Matrix<Field>& P )
+{
+    EL_DEBUG_CSE
+    Matrix<Field> PAdj;
+    Adjoint( P, PAdj );
+    Axpy( Field(1), PAdj, P );
+    Scale( Base<Field>(1)/Base<Field>(2), P );
+}
+
+template<typename Field>
+void HermitianPart( DistMatrix<Field>& P )
+{
+    EL_DEBUG_CSE
+    DistMatrix<Field> PAdj( P.Grid() );
+    Adjoint( P, PAdj );
+    Axpy( Field(1), PAdj, P );
+    Scale( Base<Field>(1)/Base<Field>(2), P );
+}
+
+} // namespace zolo
+
+// Cholesky-based QDWH
+// ====================
+
+template<typename Field>
+CholQDWHInfo CholQDWH( Matrix<Field>& A, const CholQDWHCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    if( A.Height() < A.Width() )
+    {
+        // The polar factor of A is the adjoint of that of A^H
+        Matrix<Field> AAdj;
+        Adjoint( A, AAdj );
+        auto info = CholQDWH( AAdj, ctrl );
+        Adjoint( AAdj, A );
+        return info;
+    }
+    CholQDWHInfo info;
+    Timer totalTimer, timer;
+    totalTimer.Start();
+    timer.Start();
+    Real l = zolo::Prescale( A );
+    info.estimateTime = timer.Stop();
+
+    const Real tol = Real(10)*limits::Epsilon<Real>();
+    const Real changeTol = Pow( tol, Real(1)/Real(3) );
+    vector<Real> beta(1), gamma(1);
+    Matrix<Field> ALast, S;
+    while( info.numIts < ctrl.maxIts )
+    {
+        Real a, b, c;
+        zolo::QDWHWeights( l, a, b, c );
+        beta[0] = (a-b/c)/c;
+        gamma[0] = Real(1)/c;
+
+        ALast = A;
+        zolo::AccumulateTerms( A, beta, gamma, l, S, ctrl, info );
+        Scale( b/c, A );
+        Axpy( Field(1), S, A );
+        l = Min( l*(a+b*l*l)/(Real(1)+c*l*l), Real(1) );
+        ++info.numIts;
+
+        Axpy( Field(-1), A, ALast );
+        if( FrobeniusNorm(ALast) <= changeTol && Real(1)-l <= tol )
+            break;
+    }
+    info.totalTime = totalTimer.Stop();
+    return info;
+}
+
+template<typename Field>
+CholQDWHInfo CholQDWH
+( AbstractDistMatrix<Field>& APre, const CholQDWHCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> AProx( APre );
+    auto& A = AProx.Get();
+    if( A.Height() < A.Width() )
+    {
+        DistMatrix<Field> AAdj( A.Grid() );
+        Adjoint( A, AAdj );
+        auto info = CholQDWH( AAdj, ctrl );
+        Adjoint( AAdj, A );
+        return info;
+    }
+    CholQDWHInfo info;
+    Timer totalTimer, timer;
+    totalTimer.Start();
+    timer.Start();
+    Real l = zolo::Prescale( A );
+    info.estimateTime = timer.Stop();
+
+    const Real tol = Real(10)*limits::Epsilon<Real>();
+    const Real changeTol = Pow( tol, Real(1)/Real(3) );
+    vector<Real> beta(1), gamma(1);
+    DistMatrix<Field> ALast(A.Grid()), S(A.Grid());
+    while( info.numIts < ctrl.maxIts )
+    {
+        Real a, b, c;
+        zolo::QDWHWeights( l, a, b, c );
+        beta[0] = (a-b/c)/c;
+        gamma[0] = Real(1)/c;
+
+        ALast = A;
+        zolo::AccumulateTerms( A, beta, gamma, l, S, ctrl, info );
+        Scale( b/c, A );
+        Axpy( Field(1), S, A );
+        l = Min( l*(a+b*l*l)/(Real(1)+c*l*l), Real(1) );
+        ++info.numIts;
+
+        Axpy( Field(-1), A, ALast );
+        if( FrobeniusNorm(ALast) <= changeTol && Real(1)-l <= tol )
+            break;
+    }
+    info.totalTime = totalTimer.Stop();
+    zolo::ReduceTimes( info, A.Grid().Comm() );
+    return info;
+}
+
+template<typename Field>
+CholQDWHInfo CholQDWH
+( Matrix<Field>& A,
+  Matrix<Field>& P,
+  const CholQDWHCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    Matrix<Field> ACopy( A );
+    auto info = CholQDWH( A, ctrl );
+    Gemm( ADJOINT, NORMAL, Field(1), A, ACopy, P );
+    zolo::HermitianPart( P );
+    return info;
+}
+
+template<typename Field>
+CholQDWHInfo CholQDWH
+( AbstractDistMatrix<Field>& APre,
+  AbstractDistMatrix<Field>& PPre,
+  const CholQDWHCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> AProx( APre );
+    DistMatrixWriteProxy<Field,Field,MC,MR> PProx( PPre );
+    auto& A = AProx.Get();
+    auto& P = PProx.Get();
+    DistMatrix<Field> ACopy( A );
+    auto info = CholQDWH( A, ctrl );
+    Gemm( ADJOINT, NORMAL, Field(1), A, ACopy, P );
+    zolo::HermitianPart( P );
+    return info;
+}
+
+// Zolo-PD
+// =======
+
+template<typename Field>
+CholQDWHInfo ZoloPD( Matrix<Field>& A, const ZoloPDCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    if( A.Height() < A.Width() )
+    {
+        Matrix<Field> AAdj;
+        Adjoint( A, AAdj );
+        auto info = ZoloPD( AAdj, ctrl );
+        Adjoint( AAdj, A );
+        return info;
+    }
+    CholQDWHInfo info;
+    Timer totalTimer, timer;
+    totalTimer.Start();
+    timer.Start();
+    Real l = zolo::Prescale( A );
+    const Int numTerms =
+      ( ctrl.numTerms > 0 ? ctrl.numTerms : zolo::ZolotarevNumTerms(l) );
+    info.estimateTime = timer.Stop();
+
+    const Real tol = Real(10)*limits::Epsilon<Real>();
+    const Real changeTol = Pow( tol, Real(1)/Real(3) );
+    Real alpha, lNew;
+    vector<Real> beta, gamma;
+    Matrix<Field> ALast, S;
+    while( info.numIts < ctrl.qdwhCtrl.maxIts )
+    {
+        zolo::Zolotarev( l, numTerms, alpha, beta, gamma, lNew );
+        ALast = A;
+        zolo::AccumulateTerms( A, beta, gamma, l, S, ctrl.qdwhCtrl, info );
+        Scale( alpha, A );
+        Axpy( Field(1), S, A );
+        l = lNew;
+        ++info.numIts;
+
+        Axpy( Field(-1), A, ALast );
+        if( FrobeniusNorm(ALast) <= changeTol && Real(1)-l <= tol )
+            break;
+    }
+    info.totalTime = totalTimer.Stop();
+    return info;
+}
+
+template<typename Field>
+CholQDWHInfo ZoloPD( AbstractDistMatrix<Field>& APre, const ZoloPDCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> AProx( APre );
+    auto& A = AProx.Get();
+    const Grid& g = A.Grid();
+    if( A.Height() < A.Width() )
+    {
+        DistMatrix<Field> AAdj( g );
+        Adjoint( A, AAdj );
+        auto info = ZoloPD( AAdj, ctrl );
+        Adjoint( AAdj, A );
+        return info;
+    }
+    CholQDWHInfo info;
+    Timer totalTimer, timer;
+    totalTimer.Start();
+    timer.Start();
+    Real l = zolo::Prescale( A );
+    const Int numTerms =
+      ( ctrl.numTerms > 0 ? ctrl.numTerms : zolo::ZolotarevNumTerms(l) );
+    info.estimateTime = timer.Stop();
+
+    // The subgrids are reused for every iteration
+    unique_ptr<GridPartition> termGroups;
+    if( ctrl.subgrids && numTerms > 1 && g.Size() > 1 )
+        termGroups.reset
+        ( new GridPartition( g, int(Min(Int(g.Size()),numTerms)) ) );
+
+    const Real tol = Real(10)*limits::Epsilon<Real>();
+    const Real changeTol = Pow( tol, Real(1)/Real(3) );
+    Real alpha, lNew;
+    vector<Real> beta, gamma;
+    DistMatrix<Field> ALast(g), S(g);
+    while( info.numIts < ctrl.qdwhCtrl.maxIts )
+    {
+        zolo::Zolotarev( l, numTerms, alpha, beta, gamma, lNew );
+        ALast = A;
+        if( termGroups )
+            zolo::AccumulateTerms
+            ( A, beta, gamma, l, S, *termGroups, ctrl.qdwhCtrl, info );
+        else
+            zolo::AccumulateTerms( A, beta, gamma, l, S, ctrl.qdwhCtrl, info );
+        Scale( alpha, A );
+        Axpy( Field(1), S, A );
+        l = lNew;
+        ++info.numIts;
+
+        Axpy( Field(-1), A, ALast );
+        if( FrobeniusNorm(ALast) <= changeTol && Real(1)-l <= tol )
+            break;
+    }
+    info.totalTime = totalTimer.Stop();
+    zolo::ReduceTimes( info, A.Grid().Comm() );
+    return info;
+}
+
+template<typename Field>
+CholQDWHInfo ZoloPD
+( Matrix<Field>& A,
+  Matrix<Field>& P,
+  const ZoloPDCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    Matrix<Field> ACopy( A );
+    auto info = ZoloPD( A, ctrl );
+    Gemm( ADJOINT, NORMAL, Field(1), A, ACopy, P );
+    zolo::HermitianPart( P );
+    return info;
+}
+
+template<typename Field>
+CholQDWHInfo ZoloPD
+( AbstractDistMatrix<Field>& APre,
+  AbstractDistMatrix<Field>& PPre,
+  const ZoloPDCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    DistMatrixReadWriteProxy<Field,Field,MC,MR> AProx( APre );
+    DistMatrixWriteProxy<Field,Field,MC,MR> PProx( PPre );
+    auto& A = AProx.Get();
+    auto& P = PProx.Get();
+    DistMatrix<Field> ACopy( A );
+    auto info = ZoloPD( A, ctrl );
+    Gemm( ADJOINT, NORMAL, Field(1), A, ACopy, P );
+    zolo::HermitianPart( P );
+    return info;
+}
+
+} // namespace polar
+} // namespace El
+
+#endif // ifndef EL_SPECTRAL_QDWH_HPP
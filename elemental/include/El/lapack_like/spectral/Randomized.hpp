@@ -0,0 +1,523 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_SPECTRAL_RANDOMIZED_HPP
+#define EL_SPECTRAL_RANDOMIZED_HPP
+
+namespace El {
+namespace randomized {
+
+// Test matrices
+// =============
+// Every entry of a test matrix is generated from its global index with a
+// counter-based generator, so that no random numbers need to be communicated
+// and the sketch does not depend upon the process grid.
+
+inline std::uint64_t Seed( const RandomizedCtrl& ctrl, mpi::Comm comm )
+{
+    EL_DEBUG_CSE
+    if( ctrl.seed != 0 )
+        return ctrl.seed;
+    std::uint64_t seed = Generator()();
+    mpi::Broadcast( seed, 0, comm );
+    return seed;
+}
+
+inline std::uint64_t Bits64( const CounterRNG& rng, Int i, Int j, unsigned k )
+{
+    const auto bits = rng.Bits( i, j, k );
+    return (std::uint64_t(bits[0]) << 32) | bits[1];
+}
+
+// The random sign of row i of a structured sketch
+inline Int RowSign( const CounterRNG& rng, Int i )
+{ return ( rng.Bits(i,0,1)[0] & 1u ) ? -1 : 1; }
+
+// The column of the only nonzero in row i of a count sketch
+inline Int CountSketchColumn( const CounterRNG& rng, Int i, Int width )
+{ return Int( Bits64(rng,i,0,2) % std::uint64_t(width) ); }
+
+// The entry (i,j) of the unnormalized Walsh-Hadamard matrix is
+// (-1)^popcount(i & j)
+inline Int HadamardSign( Int i, Int j )
+{
+    std::uint64_t bits = std::uint64_t(i) & std::uint64_t(j);
+    Int parity = 0;
+    while( bits )
+    {
+        parity ^= 1;
+        bits &= bits-1;
+    }
+    return ( parity ? -1 : 1 );
+}
+
+// Sample 'width' distinct columns of the Walsh-Hadamard matrix of order
+// 'paddedHeight' using Floyd's algorithm
+inline void SampleHadamardColumns
+( const CounterRNG& rng, Int paddedHeight, Int width, vector<Int>& columns )
+{
+    EL_DEBUG_CSE
+    std::set<Int> sample;
+    for( Int j=paddedHeight-width; j<paddedHeight; ++j )
+    {
+        const Int t = Int( Bits64(rng,j,0,3) % std::uint64_t(j+1) );
+        if( sample.count(t) )
+            sample.insert( j );
+        else
+            sample.insert( t );
+    }
+    columns.assign( sample.begin(), sample.end() );
+}
+
+// The n x width test matrix of the given type:
+//
+//   GAUSSIAN_SKETCH: i.i.d. standard normal entries,
+//   SRHT_SKETCH: D H S / sqrt(width), with D a random diagonal sign matrix,
+//     H the Walsh-Hadamard matrix of the next power of two above n
+//     (restricted to its first n rows), and S a random column sample,
+//   COUNT_SKETCH: a single random sign in a random column of each row.
+//
+template<typename Field>
+struct TestMatrixEntries
+{
+    SketchType type;
+    Int width;
+    const CounterRNG& rng;
+    vector<Int> columns;
+    Base<Field> scale;
+
+    TestMatrixEntries
+    ( SketchType type_, Int n, Int width_, const CounterRNG& rng_ )
+    : type(type_), width(width_), rng(rng_), scale(1)
+    {
+        if( type == SRHT_SKETCH )
+        {
+            Int paddedHeight = 1;
+            while( paddedHeight < n )
+                paddedHeight *= 2;
+            SampleHadamardColumns( rng, paddedHeight, width, columns );
+            scale = 1/Sqrt(Base<Field>(width));
+        }
+    }
+
+    Field operator()( Int i, Int j ) const
+    {
+        if( type == SRHT_SKETCH )
+            return scale*
+              Base<Field>(RowSign(rng,i)*HadamardSign(i,columns[j]));
+        else
+            return CountSketchColumn(rng,i,width) == j ?
+              Field(RowSign(rng,i)) : Field(0);
+    }
+};
+
+template<typename Field>
+void FormTestMatrix
+( SketchType type, Int n, Int width, const CounterRNG& rng,
+  Matrix<Field>& Omega )
+{
+    EL_DEBUG_CSE
+    if( type == GAUSSIAN_SKETCH )
+    {
+        Gaussian( Omega, n, width, rng );
+        return;
+    }
+    TestMatrixEntries<Field> entries( type, n, width, rng );
+    Omega.Resize( n, width );
+    for( Int j=0; j<width; ++j )
+        for( Int i=0; i<n; ++i )
+            Omega(i,j) = entries(i,j);
+}
+
+template<typename Field>
+void FormTestMatrix
+( SketchType type, Int n, Int width, const CounterRNG& rng,
+  AbstractDistMatrix<Field>& Omega )
+{
+    EL_DEBUG_CSE
+    if( type == GAUSSIAN_SKETCH )
+    {
+        Gaussian( Omega, n, width, rng );
+        return;
+    }
+    TestMatrixEntries<Field> entries( type, n, width, rng );
+    Omega.Resize( n, width );
+    const Int localHeight = Omega.LocalHeight();
+    const Int localWidth = Omega.LocalWidth();
+    for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+    {
+        const Int j = Omega.GlobalCol(jLoc);
+        for( Int iLoc=0; iLoc<localHeight; ++iLoc )
+            Omega.SetLocal( iLoc, jLoc, entries(Omega.GlobalRow(iLoc),j) );
+    }
+}
+
+// Y := A Omega
+// ============
+// Count sketches are applied in time proportional to the number of entries
+// of A rather than through a matrix-matrix multiplication.
+
+template<typename Field>
+void Sketch
+( const Matrix<Field>& A,
+  Int width,
+  SketchType type,
+  const CounterRNG& rng,
+        Matrix<Field>& Y )
+{
+    EL_DEBUG_CSE
+    const Int m = A.Height();
+    const Int n = A.Width();
+    if( type == COUNT_SKETCH )
+    {
+        Zeros( Y, m, width );
+        for( Int j=0; j<n; ++j )
+        {
+            auto y = Y( ALL, IR(CountSketchColumn(rng,j,width)) );
+            Axpy( Field(RowSign(rng,j)), A(ALL,IR(j)), y );
+        }
+    }
+    else
+    {
+        Matrix<Field> Omega;
+        FormTestMatrix( type, n, width, rng, Omega );
+        Gemm( NORMAL, NORMAL, Field(1), A, Omega, Y );
+    }
+}
+
+template<typename Field>
+void Sketch
+( const AbstractDistMatrix<Field>& APre,
+  Int width,
+  SketchType type,
+  const CounterRNG& rng,
+        AbstractDistMatrix<Field>& Y )
+{
+    EL_DEBUG_CSE
+    const Grid& g = APre.Grid();
+    const Int m = APre.Height();
+    const Int n = APre.Width();
+    if( type == COUNT_SKETCH )
+    {
+        DistMatrixReadProxy<Field,Field,MC,MR> AProx( APre );
+        auto& A = AProx.GetLocked();
+        const Int localHeight = A.LocalHeight();
+        const Int localWidth = A.LocalWidth();
+
+        // Sum the contributions of the local columns within each row team
+        DistMatrix<Field,MC,STAR> Y_MC_STAR(g);
+        Y_MC_STAR.AlignWith( A );
+        Zeros( Y_MC_STAR, m, width );
+        auto& YLoc = Y_MC_STAR.Matrix();
+        for( Int jLoc=0; jLoc<localWidth; ++jLoc )
+        {
+            const Int j = A.GlobalCol(jLoc);
+            const Int col = CountSketchColumn( rng, j, width );
+            const Field sign = RowSign( rng, j );
+            for( Int iLoc=0; iLoc<localHeight; ++iLoc )
+                YLoc(iLoc,col) += sign*A.GetLocal(iLoc,jLoc);
+        }
+        mpi::AllReduce( YLoc.Buffer(), YLoc.LDim()*width, A.RowComm() );
+        Copy( Y_MC_STAR, Y );
+    }
+    else
+    {
+        DistMatrix<Field> Omega(g);
+        FormTestMatrix( type, n, width, rng, Omega );
+        Gemm( NORMAL, NORMAL, Field(1), APre, Omega, Y );
+    }
+}
+
+} // namespace randomized
+
+// Randomized range finder
+// =======================
+// Sketch the range of A with rank+oversample columns and refine the sketch
+// with power iterations, Y := A (A' Y), orthonormalizing after each product
+// (with AutoTallSkinnyQR) to avoid losing the smaller singular directions.
+
+template<typename Field>
+void RandomizedRangeFinder
+( const Matrix<Field>& A,
+        Int rank,
+        Matrix<Field>& Q,
+  const RandomizedCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    if( rank < 1 )
+        LogicError("The rank must be positive");
+    const Int width = Min( rank+ctrl.oversample, Min(A.Height(),A.Width()) );
+    const CounterRNG rng( randomized::Seed( ctrl, mpi::COMM_SELF ) );
+
+    Matrix<Field> Z, R;
+    randomized::Sketch( A, width, ctrl.sketch, rng, Q );
+    AutoTallSkinnyQR( Q, R );
+    for( Int it=0; it<ctrl.numPowerIts; ++it )
+    {
+        Gemm( ADJOINT, NORMAL, Field(1), A, Q, Z );
+        AutoTallSkinnyQR( Z, R );
+        Gemm( NORMAL, NORMAL, Field(1), A, Z, Q );
+        AutoTallSkinnyQR( Q, R );
+    }
+}
+
+template<typename Field>
+void RandomizedRangeFinder
+( const AbstractDistMatrix<Field>& A,
+        Int rank,
+        AbstractDistMatrix<Field>& QPre,
+  const RandomizedCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    if( rank < 1 )
+        LogicError("The rank must be positive");
+    const Grid& g = A.Grid();
+    const Int width = Min( rank+ctrl.oversample, Min(A.Height(),A.Width()) );
+    const CounterRNG rng( randomized::Seed( ctrl, g.Comm() ) );
+
+    DistMatrixWriteProxy<Field,Field,MC,MR> QProx( QPre );
+    auto& Q = QProx.Get();
+    DistMatrix<Field> Z(g);
+    DistMatrix<Field,STAR,STAR> R(g);
+    randomized::Sketch( A, width, ctrl.sketch, rng, Q );
+    AutoTallSkinnyQR( Q, R );
+    for( Int it=0; it<ctrl.numPowerIts; ++it )
+    {
+        Gemm( ADJOINT, NORMAL, Field(1), A, Q, Z );
+        AutoTallSkinnyQR( Z, R );
+        Gemm( NORMAL, NORMAL, Field(1), A, Z, Q );
+        AutoTallSkinnyQR( Q, R );
+    }
+}
+
+// Randomized SVD
+// ==============
+// Given an orthonormal basis Q for the approximate range of A, the small
+// matrix Q' A = C' is formed via a tall-skinny QR factorization C = Q_C R, so
+// that, with R' = U_R Sigma V_R',
+//
+//   A ~= Q Q' A = (Q U_R) Sigma (Q_C V_R)'.
+
+template<typename Field>
+void RandomizedSVD
+( const Matrix<Field>& A,
+        Int rank,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& s,
+        Matrix<Field>& V,
+  const RandomizedCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    Matrix<Field> Q, C, R;
+    RandomizedRangeFinder( A, rank, Q, ctrl );
+    const Int width = Q.Width();
+    const Int k = Min( rank, width );
+    Gemm( ADJOINT, NORMAL, Field(1), A, Q, C );
+    AutoTallSkinnyQR( C, R );
+
+    Matrix<Field> RAdj, UR, VR;
+    Matrix<Base<Field>> sR;
+    Adjoint( R, RAdj );
+    SVD( RAdj, UR, sR, VR );
+    Gemm( NORMAL, NORMAL, Field(1), Q, UR(ALL,IR(0,k)), U );
+    Gemm( NORMAL, NORMAL, Field(1), C, VR(ALL,IR(0,k)), V );
+    s = sR( IR(0,k), ALL );
+}
+
+template<typename Field>
+void RandomizedSVD
+( const AbstractDistMatrix<Field>& A,
+        Int rank,
+        AbstractDistMatrix<Field>& U,
+        AbstractDistMatrix<Base<Field>>& sPre,
+        AbstractDistMatrix<Field>& V,
+  const RandomizedCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Grid& g = A.Grid();
+    DistMatrix<Field> Q(g), C(g);
+    DistMatrix<Field,STAR,STAR> R(g);
+    RandomizedRangeFinder( A, rank, Q, ctrl );
+    const Int width = Q.Width();
+    const Int k = Min( rank, width );
+    Gemm( ADJOINT, NORMAL, Field(1), A, Q, C );
+    AutoTallSkinnyQR( C, R );
+
+    // The small SVD is computed redundantly
+    Matrix<Field> RAdj, UR, VR;
+    Matrix<Real> sR;
+    Adjoint( R.Matrix(), RAdj );
+    SVD( RAdj, UR, sR, VR );
+
+    DistMatrix<Field,STAR,STAR> URTrunc(g), VRTrunc(g);
+    URTrunc.Resize( width, k );
+    VRTrunc.Resize( width, k );
+    URTrunc.Matrix() = UR( ALL, IR(0,k) );
+    VRTrunc.Matrix() = VR( ALL, IR(0,k) );
+    Gemm( NORMAL, NORMAL, Field(1), Q, URTrunc, U );
+    Gemm( NORMAL, NORMAL, Field(1), C, VRTrunc, V );
+
+    DistMatrixWriteProxy<Real,Real,STAR,STAR> sProx( sPre );
+    auto& s = sProx.Get();
+    s.Resize( k, 1 );
+    s.Matrix() = sR( IR(0,k), ALL );
+}
+
+// Nystrom approximation of a Hermitian positive semi-definite matrix
+// ==================================================================
+// The numerically stable variant of
+//
+//   J. A. Tropp, A. Yurtsever, M. Udell, and V. Cevher, "Fixed-rank
+//   approximation of a positive-semidefinite matrix from streaming data",
+//   Advances in Neural Information Processing Systems 30, 2017.
+//
+// With an orthonormal test matrix Omega and Y = A Omega, a small shift nu is
+// added, Y_nu = Y + nu Omega, and the approximation
+//
+//   A ~= Y_nu (Omega' Y_nu)^{-1} Y_nu' - nu I
+//
+// is formed through the Cholesky factorization Omega' Y_nu = C' C and the SVD
+// of F = Y_nu inv(C), whose squared singular values (minus the shift) are the
+// approximate eigenvalues.
+
+template<typename Field>
+void NystromHermitianApprox
+(       UpperOrLower uplo,
+  const Matrix<Field>& A,
+        Int rank,
+        Matrix<Field>& U,
+        Matrix<Base<Field>>& w,
+  const RandomizedCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int n = A.Height();
+    if( A.Width() != n )
+        LogicError("A must be square");
+    if( rank < 1 )
+        LogicError("The rank must be positive");
+    const Int width = Min( rank+ctrl.oversample, n );
+    const Int k = Min( rank, width );
+    const CounterRNG rng( randomized::Seed( ctrl, mpi::COMM_SELF ) );
+
+    Matrix<Field> Omega, Y, R;
+    randomized::FormTestMatrix( ctrl.sketch, n, width, rng, Omega );
+    AutoTallSkinnyQR( Omega, R );
+    Zeros( Y, n, width );
+    Hemm( LEFT, uplo, Field(1), A, Omega, Field(0), Y );
+    for( Int it=0; it<ctrl.numPowerIts; ++it )
+    {
+        Omega = Y;
+        AutoTallSkinnyQR( Omega, R );
+        Hemm( LEFT, uplo, Field(1), A, Omega, Field(0), Y );
+    }
+
+    const Real nu = Sqrt(Real(n))*limits::Epsilon<Real>()*FrobeniusNorm(Y);
+    Axpy( Field(nu), Omega, Y );
+    Matrix<Field> B, BAdj;
+    Gemm( ADJOINT, NORMAL, Field(1), Omega, Y, B );
+    Adjoint( B, BAdj );
+    Axpy( Field(1), BAdj, B );
+    Scale( Field(1)/Field(2), B );
+    try
+    {
+        Cholesky( UPPER, B );
+    }
+    catch( const NonHPDMatrixException& )
+    {
+        RuntimeError
+        ("The shifted Nystrom core matrix was not HPD; "
+         "is A positive semi-definite?");
+    }
+    Trsm( RIGHT, UPPER, NORMAL, NON_UNIT, Field(1), B, Y );
+
+    Matrix<Field> UR, VR;
+    Matrix<Real> sR;
+    AutoTallSkinnyQR( Y, R );
+    SVD( R, UR, sR, VR );
+    Gemm( NORMAL, NORMAL, Field(1), Y, UR(ALL,IR(0,k)), U );
+    w.Resize( k, 1 );
+    for( Int j=0; j<k; ++j )
+        w(j) = Max( sR(j)*sR(j)-nu, Real(0) );
+}
+
+template<typename Field>
+void NystromHermitianApprox
+(       UpperOrLower uplo,
+  const AbstractDistMatrix<Field>& A,
+        Int rank,
+        AbstractDistMatrix<Field>& U,
+        AbstractDistMatrix<Base<Field>>& wPre,
+  const RandomizedCtrl& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int n = A.Height();
+    if( A.Width() != n )
+        LogicError("A must be square");
+    if( rank < 1 )
+        LogicError("The rank must be positive");
+    const Grid& g = A.Grid();
+    const Int width = Min( rank+ctrl.oversample, n );
+    const Int k = Min( rank, width );
+    const CounterRNG rng( randomized::Seed( ctrl, g.Comm() ) );
+
+    DistMatrix<Field> Omega(g), Y(g);
+    DistMatrix<Field,STAR,STAR> R(g);
+    randomized::FormTestMatrix( ctrl.sketch, n, width, rng, Omega );
+    AutoTallSkinnyQR( Omega, R );
+    Zeros( Y, n, width );
+    Hemm( LEFT, uplo, Field(1), A, Omega, Field(0), Y );
+    for( Int it=0; it<ctrl.numPowerIts; ++it )
+    {
+        Omega = Y;
+        AutoTallSkinnyQR( Omega, R );
+        Hemm( LEFT, uplo, Field(1), A, Omega, Field(0), Y );
+    }
+
+    // The small Cholesky factorization and SVD are computed redundantly
+    const Real nu = Sqrt(Real(n))*limits::Epsilon<Real>()*FrobeniusNorm(Y);
+    Axpy( Field(nu), Omega, Y );
+    DistMatrix<Field,STAR,STAR> B(g);
+    Gemm( ADJOINT, NORMAL, Field(1), Omega, Y, B );
+    Matrix<Field> BAdj;
+    Adjoint( B.Matrix(), BAdj );
+    Axpy( Field(1), BAdj, B.Matrix() );
+    Scale( Field(1)/Field(2), B.Matrix() );
+    try
+    {
+        Cholesky( UPPER, B.Matrix() );
+    }
+    catch( const NonHPDMatrixException& )
+    {
+        RuntimeError
+        ("The shifted Nystrom core matrix was not HPD; "
+         "is A positive semi-definite?");
+    }
+    Trsm( RIGHT, UPPER, NORMAL, NON_UNIT, Field(1), B, Y );
+
+    Matrix<Field> UR, VR;
+    Matrix<Real> sR;
+    AutoTallSkinnyQR( Y, R );
+    SVD( R.Matrix(), UR, sR, VR );
+    DistMatrix<Field,STAR,STAR> URTrunc(g);
+    URTrunc.Resize( width, k );
+    URTrunc.Matrix() = UR( ALL, IR(0,k) );
+    Gemm( NORMAL, NORMAL, Field(1), Y, URTrunc, U );
+
+    DistMatrixWriteProxy<Real,Real,STAR,STAR> wProx( wPre );
+    auto& w = wProx.Get();
+    w.Resize( k, 1 );
+    for( Int j=0; j<k; ++j )
+        w.Matrix()(j) = Max( sR(j)*sR(j)-nu, Real(0) );
+}
+
+} // namespace El
+
+#endif // ifndef EL_SPECTRAL_RANDOMIZED_HPP
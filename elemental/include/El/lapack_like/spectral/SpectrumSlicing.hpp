@@ -0,0 +1,400 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_SPECTRAL_SPECTRUM_SLICING_HPP
+#define EL_SPECTRAL_SPECTRUM_SLICING_HPP
+
+namespace El {
+namespace slicing {
+
+// Sturm sequences for the real symmetric tridiagonal matrix with diagonal 'd'
+// and squared off-diagonal magnitudes 'eSquared'
+// ===========================================================================
+template<typename Real>
+struct SturmData
+{
+    vector<Real> d, eSquared;
+    // Gershgorin bounds on the spectrum
+    Real lowerBound, upperBound;
+    // The minimum allowed magnitude of a pivot, cf. LAPACK's {s,d}larrd
+    Real pivotMin;
+};
+
+template<typename Field>
+void FormSturmData
+( const Matrix<Base<Field>>& d,
+  const Matrix<Field>& dSub,
+  SturmData<Base<Field>>& sturm )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    const Int n = d.Height();
+    sturm.d.resize( n );
+    sturm.eSquared.resize( Max(n-1,Int(0)) );
+    Real maxESquared = 0;
+    for( Int i=0; i<n; ++i )
+        sturm.d[i] = d(i);
+    for( Int i=0; i<n-1; ++i )
+    {
+        const Real eAbs = Abs(dSub(i));
+        sturm.eSquared[i] = eAbs*eAbs;
+        maxESquared = Max( maxESquared, sturm.eSquared[i] );
+    }
+
+    sturm.lowerBound = limits::Max<Real>();
+    sturm.upperBound = limits::Lowest<Real>();
+    for( Int i=0; i<n; ++i )
+    {
+        Real radius = 0;
+        if( i > 0 )
+            radius += Abs(dSub(i-1));
+        if( i < n-1 )
+            radius += Abs(dSub(i));
+        sturm.lowerBound = Min( sturm.lowerBound, d(i)-radius );
+        sturm.upperBound = Max( sturm.upperBound, d(i)+radius );
+    }
+    sturm.pivotMin = limits::SafeMin<Real>()*Max(Real(1),maxESquared);
+}
+
+// The number of eigenvalues less than 'sigma'
+template<typename Real>
+Int SturmCount( const SturmData<Real>& sturm, const Real& sigma )
+{
+    const Int n = sturm.d.size();
+    Int count = 0;
+    Real q = 1;
+    for( Int i=0; i<n; ++i )
+    {
+        q = sturm.d[i] - sigma - ( i > 0 ? sturm.eSquared[i-1]/q : Real(0) );
+        if( Abs(q) < sturm.pivotMin )
+            q = -sturm.pivotMin;
+        if( q < Real(0) )
+            ++count;
+    }
+    return count;
+}
+
+// Bisection for the k'th smallest eigenvalue (counting from zero)
+template<typename Real>
+Real KthEigenvalue( const SturmData<Real>& sturm, Int k )
+{
+    const Real eps = limits::Epsilon<Real>();
+    Real lower = sturm.lowerBound;
+    Real upper = sturm.upperBound;
+    for( Int it=0; it<200; ++it )
+    {
+        const Real tol = 2*eps*Max(Abs(lower),Abs(upper)) + sturm.pivotMin;
+        if( upper-lower <= tol )
+            break;
+        const Real mid = (lower+upper)/2;
+        if( SturmCount( sturm, mid ) > k )
+            upper = mid;
+        else
+            lower = mid;
+    }
+    return (lower+upper)/2;
+}
+
+// Choosing the slices
+// ===================
+// The index range [firstIndex,lastIndex] is split into 'numSlices' slices of
+// (nearly) equal numbers of eigenvalues. Each boundary is then moved, within
+// 'searchWidth' indices of its nominal position, to the largest gap between
+// consecutive eigenvalues (computed via bisection) so that, whenever
+// possible, clusters of eigenvalues are not split between slices (while
+// leaving every slice at least one eigenvalue). If no gap of at least
+// relGapTol ||T||_2 could be found, the eigenvalues around the boundary which
+// are not separated by such a gap are recorded as a cluster whose
+// eigenvectors must be reorthogonalized after the slices are merged.
+struct SliceBoundaries
+{
+    // Slice s consists of the indices [offsets[s],offsets[s+1])
+    vector<Int> offsets;
+    // Inclusive index ranges of clusters straddling a slice boundary
+    vector<Int> clusterBegs, clusterEnds;
+};
+
+template<typename Real>
+void ChooseSlices
+( const SturmData<Real>& sturm,
+  Int firstIndex,
+  Int lastIndex,
+  Int numSlices,
+  Int searchWidth,
+  Real relGapTol,
+  SliceBoundaries& slices )
+{
+    EL_DEBUG_CSE
+    const Int numEig = lastIndex - firstIndex + 1;
+    if( numSlices < 1 || numSlices > numEig )
+        LogicError
+        ("Cannot split ",numEig," eigenvalues into ",numSlices," slices");
+    if( searchWidth < 0 )
+        LogicError("The search width must be non-negative");
+    const Real tNorm =
+      Max( Abs(sturm.lowerBound), Abs(sturm.upperBound) ) + sturm.pivotMin;
+    slices.offsets.resize( numSlices+1 );
+    slices.offsets[0] = firstIndex;
+    slices.offsets[numSlices] = lastIndex+1;
+    slices.clusterBegs.clear();
+    slices.clusterEnds.clear();
+
+    vector<Real> lambda;
+    for( Int s=1; s<numSlices; ++s )
+    {
+        // Leave at least one eigenvalue for this slice and for each of the
+        // slices which follow it
+        const Int minBoundary = slices.offsets[s-1] + 1;
+        const Int maxBoundary = lastIndex - (numSlices-1-s);
+        const Int nominal =
+          Min( Max( firstIndex+(s*numEig)/numSlices, minBoundary ),
+               maxBoundary );
+        const Int candBeg = Max( nominal-searchWidth, minBoundary );
+        const Int candEnd = Min( nominal+searchWidth, maxBoundary );
+
+        // lambda[j-(candBeg-1)] is the j'th eigenvalue
+        lambda.resize( candEnd-candBeg+2 );
+        for( Int j=candBeg-1; j<=candEnd; ++j )
+            lambda[j-(candBeg-1)] = KthEigenvalue( sturm, j );
+        auto relGap = [&]( Int j )
+          { return (lambda[j-(candBeg-1)]-lambda[j-candBeg])/tNorm; };
+
+        Int boundary = nominal;
+        Real bestGap = -1;
+        for( Int j=candBeg; j<=candEnd; ++j )
+        {
+            // Break ties in favor of the most balanced split
+            const Real gap = relGap(j);
+            if( gap > bestGap ||
+                (gap == bestGap && Abs(j-nominal) < Abs(boundary-nominal)) )
+            {
+                boundary = j;
+                bestGap = gap;
+            }
+        }
+        slices.offsets[s] = boundary;
+
+        if( bestGap < relGapTol )
+        {
+            Int clusterBeg = boundary-1;
+            while( clusterBeg > candBeg-1 && relGap(clusterBeg) < relGapTol )
+                --clusterBeg;
+            Int clusterEnd = boundary;
+            while( clusterEnd < candEnd && relGap(clusterEnd+1) < relGapTol )
+                ++clusterEnd;
+            slices.clusterBegs.push_back( clusterBeg );
+            slices.clusterEnds.push_back( clusterEnd );
+        }
+    }
+    for( Int s=0; s<numSlices; ++s )
+        if( slices.offsets[s] >= slices.offsets[s+1] )
+            LogicError
+            ("Slice boundaries were not strictly increasing: offsets[",s,
+             "]=",slices.offsets[s],", offsets[",s+1,"]=",
+             slices.offsets[s+1]);
+}
+
+} // namespace slicing
+
+template<typename Field>
+HermitianEigInfo
+HermitianEigSliced
+(       UpperOrLower uplo,
+        AbstractDistMatrix<Field>& A,
+        AbstractDistMatrix<Base<Field>>& wPre,
+        AbstractDistMatrix<Field>& QPre,
+  const HermitianEigSlicingCtrl<Field>& ctrl )
+{
+    EL_DEBUG_CSE
+    typedef Base<Field> Real;
+    if( A.Height() != A.Width() )
+        LogicError("Hermitian matrices must be square");
+    const Int n = A.Height();
+    const Grid& g = A.Grid();
+    const int p = g.Size();
+    const auto& tridiagEigCtrl = ctrl.eigCtrl.tridiagEigCtrl;
+    const auto& subset = tridiagEigCtrl.subset;
+    HermitianEigInfo info;
+
+    // Reduce to tridiagonal form
+    // ==========================
+    DistMatrix<Field,STAR,STAR> householderScalars(g);
+    DistMatrix<Real,STAR,STAR> signature(g);
+    herm_tridiag::BulgeChaseReflectors<Field> reflectors;
+    const bool twoStage = ctrl.useTwoStage;
+    const Int bandwidth =
+      herm_eig::TwoStageBandwidth( n, ctrl.twoStageBandwidth );
+    DistMatrix<Real,STAR,STAR> d(g);
+    DistMatrix<Field,STAR,STAR> dSub(g);
+    if( twoStage )
+    {
+        Matrix<Real> dLoc;
+        Matrix<Field> dSubLoc;
+        herm_tridiag::TwoStage
+        ( uplo, A, bandwidth, householderScalars, signature, dLoc, dSubLoc,
+          reflectors );
+        d.Resize( dLoc.Height(), 1 );
+        dSub.Resize( dSubLoc.Height(), 1 );
+        d.Matrix() = dLoc;
+        dSub.Matrix() = dSubLoc;
+    }
+    else
+    {
+        HermitianTridiag
+        ( uplo, A, householderScalars, ctrl.eigCtrl.tridiagCtrl );
+        GetRealPartOfDiagonal( A, d );
+        GetDiagonal( A, dSub, ( uplo == LOWER ? -1 : 1 ) );
+        if( uplo == UPPER )
+            Conjugate( dSub );
+    }
+
+    // Determine the requested indices and split them into slices
+    // ==========================================================
+    slicing::SturmData<Real> sturm;
+    slicing::FormSturmData( d.LockedMatrix(), dSub.LockedMatrix(), sturm );
+    Int firstIndex=0, lastIndex=n-1;
+    if( subset.indexSubset )
+    {
+        firstIndex = subset.lowerIndex;
+        lastIndex = subset.upperIndex;
+    }
+    else if( subset.rangeSubset )
+    {
+        // The eigenvalues within (lowerBound,upperBound]
+        firstIndex = slicing::SturmCount( sturm, subset.lowerBound );
+        lastIndex = slicing::SturmCount( sturm, subset.upperBound ) - 1;
+    }
+    const Int numEig = Max( lastIndex-firstIndex+1, Int(0) );
+
+    DistMatrixWriteProxy<Real,Real,STAR,STAR> wProx( wPre );
+    DistMatrixWriteProxy<Field,Field,MC,MR> QProx( QPre );
+    auto& w = wProx.Get();
+    auto& Q = QProx.Get();
+    w.Resize( numEig, 1 );
+    Q.Resize( n, numEig );
+    if( numEig == 0 )
+        return info;
+
+    Int numSlices = ( ctrl.numSlices > 0 ? ctrl.numSlices : g.Width() );
+    numSlices = Min( numSlices, Min(Int(p),numEig) );
+    slicing::SliceBoundaries slices;
+    slicing::ChooseSlices
+    ( sturm, firstIndex, lastIndex, numSlices, ctrl.searchWidth,
+      ctrl.relGapTol, slices );
+    if( ctrl.progress && g.Rank() == 0 )
+    {
+        for( Int s=0; s<numSlices; ++s )
+            Output
+            ("Slice ",s,": eigenvalues [",slices.offsets[s],",",
+             slices.offsets[s+1],")");
+        for( size_t c=0; c<slices.clusterBegs.size(); ++c )
+            Output
+            ("Cluster [",slices.clusterBegs[c],",",slices.clusterEnds[c],
+             "] straddles a slice boundary");
+    }
+
+    // Form a grid for each slice
+    // ==========================
+    // Every process takes part in the construction of each slice's grid so
+    // that the results can be translated back onto g.
+    unique_ptr<GridPartition> slicePartition
+    ( new GridPartition( g, int(numSlices) ) );
+    const bool inGrid = g.InGrid();
+    const Int mySlice = slicePartition->MyPart();
+
+    // Compute the eigenpairs of each slice on its own grid
+    // ====================================================
+    vector<unique_ptr<DistMatrix<Field>>> ZSlices(numSlices);
+    for( Int s=0; s<numSlices; ++s )
+        ZSlices[s].reset
+        ( new DistMatrix<Field>(slicePartition->PartGrid(s)) );
+    Matrix<Real> wAll;
+    Zeros( wAll, numEig, 1 );
+    if( inGrid )
+    {
+        const Grid& sliceGrid = slicePartition->PartGrid(mySlice);
+        DistMatrix<Real,STAR,STAR> dSlice(sliceGrid), wSlice(sliceGrid);
+        DistMatrix<Field,STAR,STAR> dSubSlice(sliceGrid);
+        dSlice.Resize( n, 1 );
+        dSubSlice.Resize( Max(n-1,Int(0)), 1 );
+        dSlice.Matrix() = d.LockedMatrix();
+        dSubSlice.Matrix() = dSub.LockedMatrix();
+
+        auto sliceCtrl = tridiagEigCtrl;
+        sliceCtrl.wantEigVecs = true;
+        sliceCtrl.accumulateEigVecs = false;
+        sliceCtrl.sort = ASCENDING;
+        sliceCtrl.subset.indexSubset = true;
+        sliceCtrl.subset.rangeSubset = false;
+        sliceCtrl.subset.lowerIndex = slices.offsets[mySlice];
+        sliceCtrl.subset.upperIndex = slices.offsets[mySlice+1]-1;
+        info.tridiagEigInfo =
+          HermitianTridiagEig
+          ( dSlice, dSubSlice, wSlice, *ZSlices[mySlice], sliceCtrl );
+
+        if( sliceGrid.Rank() == 0 )
+        {
+            const Int sliceOff = slices.offsets[mySlice]-firstIndex;
+            for( Int j=0; j<wSlice.Height(); ++j )
+                wAll(sliceOff+j) = wSlice.GetLocal(j,0);
+        }
+        mpi::AllReduce( wAll.Buffer(), numEig, g.Comm() );
+    }
+
+    // Merge the slices
+    // ================
+    for( Int s=0; s<numSlices; ++s )
+    {
+        const Range<Int> sliceInd
+        ( slices.offsets[s]-firstIndex, slices.offsets[s+1]-firstIndex );
+        ZSlices[s]->Resize( n, sliceInd.end-sliceInd.beg );
+        DistMatrix<Field> ZTrans(g);
+        copy::TranslateBetweenGrids( *ZSlices[s], ZTrans );
+        ZSlices[s].reset();
+        auto QSlice = Q( ALL, sliceInd );
+        QSlice = ZTrans;
+    }
+    ZSlices.clear();
+    slicePartition.reset();
+    w.Matrix() = wAll;
+
+    // Eigenvectors computed on different slices are only orthogonal to
+    // working precision if their eigenvalues are well-separated, so those
+    // belonging to clusters which straddle a slice boundary are
+    // reorthogonalized
+    for( size_t c=0; c<slices.clusterBegs.size(); ++c )
+    {
+        const Int clusterBeg = slices.clusterBegs[c]-firstIndex;
+        const Int clusterEnd = slices.clusterEnds[c]-firstIndex+1;
+        const Range<Int> clusterInd( clusterBeg, clusterEnd );
+        auto QCluster = Q( ALL, clusterInd );
+        qr::ExplicitUnitary( QCluster );
+    }
+
+    // Backtransform the tridiagonal eigenvectors
+    // ==========================================
+    if( twoStage )
+        herm_tridiag::ApplyTwoStageQ
+        ( A, bandwidth, householderScalars, signature, reflectors, Q );
+    else
+        herm_tridiag::ApplyQ( LEFT, uplo, NORMAL, A, householderScalars, Q );
+
+    if( tridiagEigCtrl.sort == DESCENDING )
+    {
+        for( Int j=0; j<numEig/2; ++j )
+        {
+            std::swap( w.Matrix()(j), w.Matrix()(numEig-1-j) );
+            ColSwap( Q, j, numEig-1-j );
+        }
+    }
+    return info;
+}
+
+} // namespace El
+
+#endif // ifndef EL_SPECTRAL_SPECTRUM_SLICING_HPP
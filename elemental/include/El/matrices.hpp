@@ -647,6 +647,27 @@ void Gaussian
 ( DistMultiVec<Field>& A, Int m, Int n,
   Field mean=0, Base<Field> stddev=1 );
 
+// Draw the (i,j) entry from the counter (i,j) of a counter-based generator so
+// that the result is independent of the distribution and of the number of
+// threads and processes; the entries are generated in parallel.
+template<typename Field>
+void MakeGaussian
+( Matrix<Field>& A, const CounterRNG& rng,
+  Field mean=0, Base<Field> stddev=1 );
+template<typename Field>
+void MakeGaussian
+( AbstractDistMatrix<Field>& A, const CounterRNG& rng,
+  Field mean=0, Base<Field> stddev=1 );
+
+template<typename Field>
+void Gaussian
+( Matrix<Field>& A, Int m, Int n, const CounterRNG& rng,
+  Field mean=0, Base<Field> stddev=1 );
+template<typename Field>
+void Gaussian
+( AbstractDistMatrix<Field>& A, Int m, Int n, const CounterRNG& rng,
+  Field mean=0, Base<Field> stddev=1 );
+
 // Rademacher
 // ----------
 template<typename T>
@@ -679,6 +700,24 @@ void Uniform
 template<typename T>
 void Uniform( DistMultiVec<T>& X, Int m, Int n, T center=0, Base<T> radius=1 );
 
+// Counter-based variants (see the corresponding Gaussian routines)
+template<typename T>
+void MakeUniform
+( Matrix<T>& A, const CounterRNG& rng, T center=0, Base<T> radius=1 );
+template<typename T>
+void MakeUniform
+( AbstractDistMatrix<T>& A, const CounterRNG& rng,
+  T center=0, Base<T> radius=1 );
+
+template<typename T>
+void Uniform
+( Matrix<T>& A, Int m, Int n, const CounterRNG& rng,
+  T center=0, Base<T> radius=1 );
+template<typename T>
+void Uniform
+( AbstractDistMatrix<T>& A, Int m, Int n, const CounterRNG& rng,
+  T center=0, Base<T> radius=1 );
+
 // Lattice bases
 // =============
 
@@ -784,5 +823,6 @@ void Wigner
 // TODO(poulson): Group these into a small number of includes of parent dir's
 #include <El/matrices/deterministic/classical/Circulant.hpp>
 #include <El/matrices/deterministic/lattice/NTRUAttack.hpp>
+#include <El/matrices/random/independent/CounterBased.hpp>
 
 #endif // ifndef EL_MATRICES_HPP
@@ -0,0 +1,101 @@
+/*
+   Copyright (c) 2009-2016, Jack Poulson
+   All rights reserved.
+
+   This file is part of Elemental and is under the BSD 2-Clause License,
+   which can be found in the LICENSE file in the root directory, or at
+   http://opensource.org/licenses/BSD-2-Clause
+*/
+#ifndef EL_MATRICES_RANDOM_INDEPENDENT_COUNTERBASED_HPP
+#define EL_MATRICES_RANDOM_INDEPENDENT_COUNTERBASED_HPP
+
+namespace El {
+
+// Every process draws precisely the entries it stores (including redundant
+// copies, which are therefore drawn identically), and no communication is
+// required.
+
+template<typename Field>
+void MakeGaussian
+( Matrix<Field>& A, const CounterRNG& rng, Field mean, Base<Field> stddev )
+{
+    EL_DEBUG_CSE
+    IndexDependentMap
+    ( A, [=]( Int i, Int j, const Field& ) -> Field
+         { return rng.Normal( i, j, mean, stddev ); } );
+}
+
+template<typename Field>
+void MakeGaussian
+( AbstractDistMatrix<Field>& A, const CounterRNG& rng,
+  Field mean, Base<Field> stddev )
+{
+    EL_DEBUG_CSE
+    IndexDependentMap
+    ( A, [=]( Int i, Int j, const Field& ) -> Field
+         { return rng.Normal( i, j, mean, stddev ); } );
+}
+
+template<typename Field>
+void Gaussian
+( Matrix<Field>& A, Int m, Int n, const CounterRNG& rng,
+  Field mean, Base<Field> stddev )
+{
+    EL_DEBUG_CSE
+    A.Resize( m, n );
+    MakeGaussian( A, rng, mean, stddev );
+}
+
+template<typename Field>
+void Gaussian
+( AbstractDistMatrix<Field>& A, Int m, Int n, const CounterRNG& rng,
+  Field mean, Base<Field> stddev )
+{
+    EL_DEBUG_CSE
+    A.Resize( m, n );
+    MakeGaussian( A, rng, mean, stddev );
+}
+
+template<typename T>
+void MakeUniform
+( Matrix<T>& A, const CounterRNG& rng, T center, Base<T> radius )
+{
+    EL_DEBUG_CSE
+    IndexDependentMap
+    ( A, [=]( Int i, Int j, const T& ) -> T
+         { return rng.Ball( i, j, center, radius ); } );
+}
+
+template<typename T>
+void MakeUniform
+( AbstractDistMatrix<T>& A, const CounterRNG& rng, T center, Base<T> radius )
+{
+    EL_DEBUG_CSE
+    IndexDependentMap
+    ( A, [=]( Int i, Int j, const T& ) -> T
+         { return rng.Ball( i, j, center, radius ); } );
+}
+
+template<typename T>
+void Uniform
+( Matrix<T>& A, Int m, Int n, const CounterRNG& rng,
+  T center, Base<T> radius )
+{
+    EL_DEBUG_CSE
+    A.Resize( m, n );
+    MakeUniform( A, rng, center, radius );
+}
+
+template<typename T>
+void Uniform
+( AbstractDistMatrix<T>& A, Int m, Int n, const CounterRNG& rng,
+  T center, Base<T> radius )
+{
+    EL_DEBUG_CSE
+    A.Resize( m, n );
+    MakeUniform( A, rng, center, radius );
+}
+
+} // namespace El
+
+#endif // ifndef EL_MATRICES_RANDOM_INDEPENDENT_COUNTERBASED_HPP